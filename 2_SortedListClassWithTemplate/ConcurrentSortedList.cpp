@@ -0,0 +1,447 @@
+// ConcurrentSortedList.cpp
+// Scott Elliott
+
+// Implementation file for the ConcurrentSortedList template class and the
+// epoch-based reclamation domain it relies on.
+// The skip list follows the lock-free design of Fraser and of Herlihy & Shavit:
+// a node is logically deleted by marking its links top-down, and is physically
+// unlinked by whichever thread next walks past it.
+
+#include "ConcurrentSortedList.h"
+#include <mutex>
+#include <new>
+#include <thread>
+#include <vector>
+
+// ============================================================================
+// EPOCH DOMAIN IMPLEMENTATION
+// ============================================================================
+
+namespace {
+
+// Upper bound on threads that can be registered with the domain at once
+const int kMaxThreads = 256;
+
+// Number of retirements between attempts to advance the epoch and free memory
+const int kCollectInterval = 64;
+
+// Per-thread announcement, padded to its own cache line to avoid false sharing.
+// Holds (epoch << 1) | 1 while the thread is pinned, 0 while it is quiescent.
+struct alignas(64) EpochSlot {
+  std::atomic<std::uint64_t> state{ 0 };
+  std::atomic<bool> inUse{ false };
+};
+
+// A piece of retired memory and the epoch in which it was retired
+struct Retired {
+  void* ptr;
+  void (*deleter)(void*);
+  std::uint64_t epoch;
+};
+
+std::atomic<std::uint64_t> globalEpoch{ 2 };
+EpochSlot slots[kMaxThreads];
+
+// Retired memory left behind by threads that have exited
+std::mutex orphanMutex;
+std::vector<Retired> orphans;
+
+// Advances the global epoch if every pinned thread has seen the current one.
+// The fence orders the caller's earlier unlinks before the scan and pairs
+// with the fence in Guard::Guard. Returns the global epoch after the attempt.
+std::uint64_t tryAdvance() {
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  std::uint64_t epoch = globalEpoch.load(std::memory_order_seq_cst);
+  for (const EpochSlot& slot : slots) {
+    std::uint64_t state = slot.state.load(std::memory_order_seq_cst);
+    if ((state & 1) != 0 && (state >> 1) != epoch)
+      return epoch;
+  }
+  globalEpoch.compare_exchange_strong(epoch, epoch + 1, std::memory_order_seq_cst);
+  return globalEpoch.load(std::memory_order_seq_cst);
+}
+
+// Frees every entry retired at least two epochs before current; keeps the rest
+void collect(std::vector<Retired>& bag, std::uint64_t current) {
+  std::size_t kept = 0;
+  for (Retired& r : bag) {
+    if (r.epoch + 2 <= current)
+      r.deleter(r.ptr);
+    else
+      bag[kept++] = r;
+  }
+  bag.resize(kept);
+}
+
+// Thread registration: claims a slot on first use and hands any unreclaimed
+// memory to the orphan list when the thread exits.
+struct ThreadRecord {
+  EpochSlot* slot = nullptr;
+  int depth = 0;                   // Guard nesting depth
+  int sinceCollect = 0;            // Retirements since the last collection
+  std::vector<Retired> bag;        // Memory retired by this thread
+
+  ThreadRecord() {
+    for (;;) {
+      for (EpochSlot& s : slots) {
+        bool expected = false;
+        if (s.inUse.compare_exchange_strong(expected, true)) {
+          slot = &s;
+          return;
+        }
+      }
+      std::this_thread::yield();   // All slots taken; wait for a thread to exit
+    }
+  }
+
+  ~ThreadRecord() {
+    collect(bag, tryAdvance());
+    if (!bag.empty()) {
+      std::lock_guard<std::mutex> lock(orphanMutex);
+      orphans.insert(orphans.end(), bag.begin(), bag.end());
+    }
+    slot->state.store(0, std::memory_order_seq_cst);
+    slot->inUse.store(false, std::memory_order_release);
+  }
+};
+
+ThreadRecord& threadRecord() {
+  thread_local ThreadRecord record;
+  return record;
+}
+
+// Frees orphaned memory at process exit, when no list operation can be running
+struct OrphanReaper {
+  ~OrphanReaper() {
+    std::lock_guard<std::mutex> lock(orphanMutex);
+    for (Retired& r : orphans)
+      r.deleter(r.ptr);
+    orphans.clear();
+  }
+} orphanReaper;
+
+} // namespace
+
+// Guard Constructor
+// Announces the current epoch. A seq_cst store alone does not keep the
+// operation's later acquire loads of the links from being reordered before
+// it, so the fence after it does; it pairs with the fence in tryAdvance, so
+// either the advancing thread sees this announcement or this thread sees the
+// advanced epoch. The epoch is then re-read and the announcement repeated if
+// it moved in between, so the thread is never pinned to a stale epoch.
+EpochDomain::Guard::Guard() {
+  ThreadRecord& rec = threadRecord();
+  if (rec.depth++ == 0) {
+    std::uint64_t epoch = globalEpoch.load(std::memory_order_seq_cst);
+    for (;;) {
+      rec.slot->state.store((epoch << 1) | 1, std::memory_order_seq_cst);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      std::uint64_t current = globalEpoch.load(std::memory_order_seq_cst);
+      if (current == epoch)
+        break;
+      epoch = current;
+    }
+  }
+}
+
+// Guard Destructor
+// Returns the thread to the quiescent state when the outermost guard ends.
+EpochDomain::Guard::~Guard() {
+  ThreadRecord& rec = threadRecord();
+  if (--rec.depth == 0) {
+    rec.slot->state.store(0, std::memory_order_release);
+  }
+}
+
+// Retire Method
+// Stamps p with the current epoch and periodically frees what has aged out.
+// Orphans from exited threads are swept on the same schedule.
+void EpochDomain::retire(void* p, void (*deleter)(void*)) {
+  ThreadRecord& rec = threadRecord();
+  rec.bag.push_back(Retired{ p, deleter, globalEpoch.load(std::memory_order_seq_cst) });
+  if (++rec.sinceCollect >= kCollectInterval) {
+    rec.sinceCollect = 0;
+    std::uint64_t current = tryAdvance();
+    collect(rec.bag, current);
+    std::unique_lock<std::mutex> lock(orphanMutex, std::try_to_lock);
+    if (lock.owns_lock())
+      collect(orphans, current);
+  }
+}
+
+// ============================================================================
+// MARKED POINTER HELPERS
+// ============================================================================
+
+namespace {
+
+const std::uintptr_t kMark = 1;
+
+inline bool isMarked(std::uintptr_t link) { return (link & kMark) != 0; }
+
+template <typename NodeT>
+inline NodeT* toNode(std::uintptr_t link) {
+  return reinterpret_cast<NodeT*>(link & ~kMark);
+}
+
+template <typename NodeT>
+inline std::uintptr_t toLink(NodeT* node) {
+  return reinterpret_cast<std::uintptr_t>(node);
+}
+
+} // namespace
+
+// ============================================================================
+// CORE METHODS IMPLEMENTATION
+// ============================================================================
+
+// Create Node Helper
+// Allocates the node and its tower of links in one block and constructs them.
+template <typename Object>
+typename ConcurrentSortedList<Object>::Node*
+ConcurrentSortedList<Object>::createNode(const Object& item, int levels) {
+  std::size_t bytes = sizeof(Node) + (levels - 1) * sizeof(std::atomic<std::uintptr_t>);
+  void* raw = ::operator new(bytes);
+  Node* n;
+  try {
+    n = ::new (raw) Node(item, levels);
+  }
+  catch (...) {
+    ::operator delete(raw);
+    throw;
+  }
+  for (int level = 0; level < levels; ++level)
+    ::new (static_cast<void*>(&n->next[level])) std::atomic<std::uintptr_t>(0);
+  return n;
+}
+
+// Destroy Node Helper
+// Type-erased so the epoch domain can free nodes after the list is gone.
+template <typename Object>
+void ConcurrentSortedList<Object>::destroyNode(void* p) {
+  Node* n = static_cast<Node*>(p);
+  n->~Node();
+  ::operator delete(p);
+}
+
+// Release Helper
+// A node is shared by its inserter (until its tower is fully linked) and its
+// remover (until it is unlinked); the last of the two to finish retires it.
+template <typename Object>
+void ConcurrentSortedList<Object>::release(Node* n) {
+  if (n->pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    EpochDomain::retire(n, &destroyNode);
+}
+
+// Random Level Helper
+// Each extra level is kept with probability 1/2, using a per-thread xorshift.
+template <typename Object>
+int ConcurrentSortedList<Object>::randomLevel() {
+  thread_local std::uint64_t state =
+    0x9E3779B97F4A7C15ull ^ reinterpret_cast<std::uintptr_t>(&state);
+  state ^= state << 13;
+  state ^= state >> 7;
+  state ^= state << 17;
+  int level = 1;
+  std::uint64_t bits = state;
+  while (level < MAX_LEVEL && (bits & 1) != 0) {
+    ++level;
+    bits >>= 1;
+  }
+  return level;
+}
+
+// Default Constructor
+// The head tower spans every level; a nullptr link stands for the tail.
+template <typename Object>
+ConcurrentSortedList<Object>::ConcurrentSortedList() : listSize(0) {
+  head = createNode(Object{}, MAX_LEVEL);
+}
+
+// Destructor
+// With no operation in flight every removed node has been unlinked and handed
+// to the epoch domain, so the bottom level links exactly the nodes still owned.
+template <typename Object>
+ConcurrentSortedList<Object>::~ConcurrentSortedList() {
+  Node* current = head;
+  while (current != nullptr) {
+    Node* nextNode = toNode<Node>(current->next[0].load(std::memory_order_relaxed));
+    destroyNode(current);
+    current = nextNode;
+  }
+}
+
+// ============================================================================
+// HELPER METHODS IMPLEMENTATION
+// ============================================================================
+
+// Find Helper
+// Descends from the top level. At each level it skips forward while the next
+// node is before item, and swings the predecessor's link past any marked node
+// it meets. A failed swing means the predecessor changed, so the search restarts.
+template <typename Object>
+bool ConcurrentSortedList<Object>::find(const Object& item, Node** preds, Node** succs) const {
+retry:
+  Node* pred = head;
+  Node* curr = nullptr;
+  for (int level = MAX_LEVEL - 1; level >= 0; --level) {
+    curr = toNode<Node>(pred->next[level].load(std::memory_order_acquire));
+    while (curr != nullptr) {
+      std::uintptr_t succ = curr->next[level].load(std::memory_order_acquire);
+      while (isMarked(succ)) {
+        std::uintptr_t expected = toLink(curr);
+        if (!pred->next[level].compare_exchange_strong(expected, succ & ~kMark,
+          std::memory_order_acq_rel, std::memory_order_acquire))
+          goto retry;
+        curr = toNode<Node>(succ);
+        if (curr == nullptr)
+          break;
+        succ = curr->next[level].load(std::memory_order_acquire);
+      }
+      if (curr != nullptr && curr->data < item) {
+        pred = curr;
+        curr = toNode<Node>(succ);
+      }
+      else {
+        break;
+      }
+    }
+    preds[level] = pred;
+    succs[level] = curr;
+  }
+  return curr != nullptr && curr->data == item;
+}
+
+// ============================================================================
+// ACCESSORS AND MUTATORS IMPLEMENTATION
+// ============================================================================
+
+// Contains Method
+// Same descent as find, but marked nodes are stepped over instead of unlinked,
+// so the reader never writes and never restarts.
+template <typename Object>
+bool ConcurrentSortedList<Object>::contains(const Object& item) const {
+  EpochDomain::Guard guard;
+  Node* pred = head;
+  Node* curr = nullptr;
+  std::uintptr_t succ = 0;
+  for (int level = MAX_LEVEL - 1; level >= 0; --level) {
+    curr = toNode<Node>(pred->next[level].load(std::memory_order_acquire));
+    while (curr != nullptr) {
+      succ = curr->next[level].load(std::memory_order_acquire);
+      if (isMarked(succ)) {
+        curr = toNode<Node>(succ);
+      }
+      else if (curr->data < item) {
+        pred = curr;
+        curr = toNode<Node>(succ);
+      }
+      else {
+        break;
+      }
+    }
+  }
+  return curr != nullptr && !isMarked(succ) && curr->data == item;
+}
+
+// Insert Method
+// Links the new node into the bottom level first (the linearization point),
+// then climbs its tower. If a remover marks the node mid-climb, the inserter
+// stops and makes sure no link it published is left behind.
+template <typename Object>
+bool ConcurrentSortedList<Object>::insert(const Object& item) {
+  EpochDomain::Guard guard;
+  Node* preds[MAX_LEVEL];
+  Node* succs[MAX_LEVEL];
+  Node* n = nullptr;
+
+  for (;;) {
+    if (find(item, preds, succs)) {
+      if (n != nullptr)
+        destroyNode(n);            // Never published, so no grace period needed
+      return false;
+    }
+    if (n == nullptr) {
+      try {
+        n = createNode(item, randomLevel());
+      }
+      catch (const std::bad_alloc&) {
+        return false;
+      }
+    }
+    for (int level = 0; level < n->topLevel; ++level)
+      n->next[level].store(toLink(succs[level]), std::memory_order_relaxed);
+
+    std::uintptr_t expected = toLink(succs[0]);
+    if (preds[0]->next[0].compare_exchange_strong(expected, toLink(n),
+      std::memory_order_acq_rel, std::memory_order_acquire))
+      break;
+  }
+  listSize.fetch_add(1, std::memory_order_relaxed);
+
+  for (int level = 1; level < n->topLevel; ++level) {
+    for (;;) {
+      std::uintptr_t link = n->next[level].load(std::memory_order_acquire);
+      if (isMarked(link))
+        goto linked;               // Being removed: stop climbing
+      if (toNode<Node>(link) != succs[level] &&
+        !n->next[level].compare_exchange_strong(link, toLink(succs[level]),
+          std::memory_order_acq_rel, std::memory_order_acquire))
+        continue;
+      std::uintptr_t expected = toLink(succs[level]);
+      if (preds[level]->next[level].compare_exchange_strong(expected, toLink(n),
+        std::memory_order_acq_rel, std::memory_order_acquire))
+        break;
+      find(item, preds, succs);    // Neighbourhood changed; refresh it
+      if (succs[0] != n)
+        goto linked;               // Already removed and unlinked below
+    }
+  }
+
+linked:
+  if (isMarked(n->next[0].load(std::memory_order_acquire)))
+    find(item, preds, succs);      // Unlink anything published after the mark
+  release(n);
+  return true;
+}
+
+// Remove Method
+// Marks the victim's links from the top down; the thread whose mark lands on
+// the bottom link owns the removal (the linearization point) and unlinks it.
+template <typename Object>
+bool ConcurrentSortedList<Object>::remove(const Object& item) {
+  EpochDomain::Guard guard;
+  Node* preds[MAX_LEVEL];
+  Node* succs[MAX_LEVEL];
+
+  if (!find(item, preds, succs))
+    return false;
+  Node* victim = succs[0];
+
+  for (int level = victim->topLevel - 1; level >= 1; --level) {
+    std::uintptr_t link = victim->next[level].load(std::memory_order_acquire);
+    while (!isMarked(link) &&
+      !victim->next[level].compare_exchange_weak(link, link | kMark,
+        std::memory_order_acq_rel, std::memory_order_acquire)) {
+    }
+  }
+
+  std::uintptr_t link = victim->next[0].load(std::memory_order_acquire);
+  for (;;) {
+    if (isMarked(link))
+      return false;                // Another thread removed it first
+    if (victim->next[0].compare_exchange_strong(link, link | kMark,
+      std::memory_order_acq_rel, std::memory_order_acquire))
+      break;
+  }
+  listSize.fetch_sub(1, std::memory_order_relaxed);
+  find(item, preds, succs);        // Unlink the victim at every level
+  release(victim);
+  return true;
+}
+
+// ============================================================================
+// EXPLICIT TEMPLATE INSTANTIATIONS
+// ============================================================================
+template class ConcurrentSortedList<int>;
+template class ConcurrentSortedList<std::string>;
@@ -0,0 +1,108 @@
+// ConcurrentSortedList.h
+// Scott Elliott
+
+
+// This header file defines a Concurrent Sorted List Class with Template that
+// many threads can insert into, remove from and search at the same time
+// without a lock. It implements a lock-free skip list:
+//   - insert and remove are linearizable at the compare-and-swap that links
+//     or marks the node in the bottom level;
+//   - contains never writes shared memory and never retries, so readers are
+//     wait-free;
+//   - removed nodes are reclaimed through epoch-based reclamation, so a node
+//     is only freed once no thread can still be looking at it.
+// Unlike SortedList, the concurrent list holds each value at most once
+// (insert of a present value returns false).
+
+#ifndef CONCURRENTSORTEDLIST_H
+#define CONCURRENTSORTEDLIST_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <string>
+
+// --- Epoch-Based Reclamation ---
+// Process-wide reclamation domain shared by every ConcurrentSortedList.
+// A thread pins the current epoch (with a Guard) for the duration of each
+// list operation. Retired memory is freed once the global epoch has advanced
+// twice past the epoch it was retired in, which guarantees every thread that
+// could have held a reference has since unpinned.
+class EpochDomain {
+public:
+  // Pins the calling thread for the lifetime of the guard. Guards nest.
+  class Guard {
+  public:
+    Guard();
+    ~Guard();
+    Guard(const Guard&) = delete;
+    Guard& operator=(const Guard&) = delete;
+  };
+
+  // Hands p to the domain; deleter(p) runs once no pinned thread can see p.
+  // Must be called while the calling thread is pinned.
+  static void retire(void* p, void (*deleter)(void*));
+};
+
+template <typename Object>
+class ConcurrentSortedList {
+private:
+  // Highest tower a node can have; 2^24 elements before levels saturate
+  static const int MAX_LEVEL = 24;
+
+  // Node structure for the skip list
+  // The next pointers form a tower of topLevel atomic links allocated inline
+  // after the node. The low bit of a link marks the node as logically deleted
+  // at that level.
+  struct Node {
+    Object data;                   // The stored element
+    int topLevel;                  // Number of levels this node is linked in
+    std::atomic<int> pending;      // Owners (inserter, remover) yet to let go
+    std::atomic<std::uintptr_t> next[1]; // First of topLevel tower links
+
+    Node(const Object& d, int levels) : data(d), topLevel(levels), pending(2) {}
+  };
+
+  Node* head;                      // Sentinel tower of MAX_LEVEL links
+  std::atomic<int> listSize;       // Number of elements currently present
+
+  // Helper methods to allocate and free a node with a tower of the given height
+  static Node* createNode(const Object& item, int levels);
+  static void destroyNode(void* p);
+
+  // Helper method that drops one ownership of a node; the last owner retires it
+  static void release(Node* n);
+
+  // Helper method to pick a tower height with a geometric distribution
+  static int randomLevel();
+
+  // Helper method that finds, at every level, the last node before item (preds)
+  // and the first node not before it (succs), unlinking marked nodes on the way.
+  // Returns true if an unmarked node equal to item is present.
+  bool find(const Object& item, Node** preds, Node** succs) const;
+
+public:
+  // --- Core Methods ---
+
+  // Default constructor: Creates an empty list with a sentinel head tower.
+  ConcurrentSortedList();
+
+  // Destructor: Frees every node still linked. No other thread may be using
+  // the list once destruction begins.
+  ~ConcurrentSortedList();
+
+  // A lock-free list is shared, not copied
+  ConcurrentSortedList(const ConcurrentSortedList&) = delete;
+  ConcurrentSortedList& operator=(const ConcurrentSortedList&) = delete;
+
+  // --- Accessors ---
+  int size() const { return listSize.load(std::memory_order_relaxed); }
+  bool empty() const { return size() == 0; }
+  bool contains(const Object& item) const;     // Wait-free membership test
+
+  // --- Mutators ---
+  bool insert(const Object& item);             // Insert item if absent
+  bool remove(const Object& item);             // Remove item if present
+};
+
+#endif // CONCURRENTSORTEDLIST_H
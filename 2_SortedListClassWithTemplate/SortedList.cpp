@@ -3,45 +3,324 @@
 
 // Implementation file for the SortedList template class.
 // This file contains the definitions of all methods declared in SortedList.h
-// Uses a doubly-linked *linear* list with a dummy header node for simplified
-// insertion, deletion, and traversal. The list terminates with nullptr at the tail.
+// The linked layout uses a doubly-linked *linear* list with a dummy header node
+// for simplified insertion, deletion, and traversal. The list terminates with
+// nullptr at the tail. The contiguous layout keeps one sorted array, and the
+// unrolled layout keeps a linked list of sorted fixed-size blocks.
 
 #include "SortedList.h"
 #include <stdexcept>
 #include <algorithm>
+#include <type_traits>
+#include <cstring>
+#include <charconv>
+#include <cstdint>
+#include <limits>
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+// ============================================================================
+// SERIALIZATION AND TEXT OUTPUT HELPERS
+// ============================================================================
+// Binary format (all integers are LEB128 varints unless noted):
+//   "SLST"  4-byte magic
+//   1       format version (one byte)
+//   kind    element encoding (one byte): 1 = integer deltas, 2 = strings,
+//           3 = raw bytes
+//   count   number of elements
+//   bytes   payload size, so a reader never consumes past the list
+//   payload the elements in ascending order:
+//           integers: first value zigzag-encoded, then the non-negative
+//                     difference from the previous value
+//           strings:  length, then the bytes
+//           raw:      sizeof(Object) bytes each
+
+namespace {
+
+const char kMagic[4] = { 'S', 'L', 'S', 'T' };
+const unsigned char kVersion = 1;
+enum ElementKind : unsigned char { kIntegerDeltas = 1, kStrings = 2, kRawBytes = 3 };
+
+void putVarint(std::string& out, std::uint64_t v) {
+  while (v >= 0x80) {
+    out.push_back(static_cast<char>(v | 0x80));
+    v >>= 7;
+  }
+  out.push_back(static_cast<char>(v));
+}
+
+bool getVarint(const char*& p, const char* end, std::uint64_t& v) {
+  v = 0;
+  for (int shift = 0; shift < 64 && p < end; shift += 7) {
+    unsigned char byte = static_cast<unsigned char>(*p++);
+    v |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+    if ((byte & 0x80) == 0)
+      return true;
+  }
+  return false;
+}
+
+// Reads a varint one byte at a time so the stream is left right after it
+bool getVarint(std::istream& is, std::uint64_t& v) {
+  v = 0;
+  for (int shift = 0; shift < 64; shift += 7) {
+    int byte = is.get();
+    if (byte == std::char_traits<char>::eof())
+      return false;
+    v |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+    if ((byte & 0x80) == 0)
+      return true;
+  }
+  return false;
+}
+
+template <typename Object>
+ElementKind elementKind() {
+  if constexpr (std::is_integral<Object>::value)
+    return kIntegerDeltas;
+  else if constexpr (std::is_same<Object, std::string>::value)
+    return kStrings;
+  else
+    return kRawBytes;
+}
+
+// Appends one element; prev is the element before it, or nullptr for the first
+template <typename Object>
+void encodeElement(std::string& out, const Object& item, const Object* prev) {
+  if constexpr (std::is_integral<Object>::value) {
+    if (prev == nullptr) {
+      std::int64_t v = static_cast<std::int64_t>(item);
+      putVarint(out, (static_cast<std::uint64_t>(v) << 1) ^ static_cast<std::uint64_t>(v >> 63));
+    }
+    else {
+      putVarint(out, static_cast<std::uint64_t>(item) - static_cast<std::uint64_t>(*prev));
+    }
+  }
+  else if constexpr (std::is_same<Object, std::string>::value) {
+    putVarint(out, item.size());
+    out.append(item);
+  }
+  else {
+    static_assert(std::is_trivially_copyable<Object>::value,
+      "binary serialization supports integers, std::string and trivially copyable types");
+    out.append(reinterpret_cast<const char*>(&item), sizeof(Object));
+  }
+}
+
+// Reads one element into item. Rejects truncated input, out-of-range values
+// and elements that would break the ascending order.
+template <typename Object>
+bool decodeElement(const char*& p, const char* end, Object& item, const Object* prev) {
+  if constexpr (std::is_integral<Object>::value) {
+    std::uint64_t raw;
+    if (!getVarint(p, end, raw))
+      return false;
+    if (prev == nullptr) {
+      std::int64_t v = static_cast<std::int64_t>(raw >> 1) ^ -static_cast<std::int64_t>(raw & 1);
+      if (v < static_cast<std::int64_t>(std::numeric_limits<Object>::min()) ||
+        (v > 0 && static_cast<std::uint64_t>(v) > static_cast<std::uint64_t>(std::numeric_limits<Object>::max())))
+        return false;
+      item = static_cast<Object>(v);
+    }
+    else {
+      std::uint64_t room = static_cast<std::uint64_t>(std::numeric_limits<Object>::max()) -
+        static_cast<std::uint64_t>(*prev);
+      if (raw > room)
+        return false;
+      item = static_cast<Object>(static_cast<std::uint64_t>(*prev) + raw);
+    }
+    return true;
+  }
+  else if constexpr (std::is_same<Object, std::string>::value) {
+    std::uint64_t length;
+    if (!getVarint(p, end, length) || length > static_cast<std::uint64_t>(end - p))
+      return false;
+    item.assign(p, static_cast<std::size_t>(length));
+    p += length;
+    return prev == nullptr || !(item < *prev);
+  }
+  else {
+    if (static_cast<std::size_t>(end - p) < sizeof(Object))
+      return false;
+    std::memcpy(static_cast<void*>(&item), p, sizeof(Object));
+    p += sizeof(Object);
+    return prev == nullptr || !(item < *prev);
+  }
+}
+
+// Encodes count elements visited in order by forEach(callback) and writes the
+// header and payload with two stream writes.
+template <typename Object, typename ForEach>
+bool writeBinary(std::ostream& os, std::size_t count, ForEach forEach) {
+  std::string payload;
+  const Object* prev = nullptr;
+  forEach([&](const Object& item) {
+    encodeElement(payload, item, prev);
+    prev = &item;
+    });
+
+  std::string header(kMagic, sizeof(kMagic));
+  header.push_back(static_cast<char>(kVersion));
+  header.push_back(static_cast<char>(elementKind<Object>()));
+  putVarint(header, count);
+  putVarint(header, payload.size());
+  os.write(header.data(), static_cast<std::streamsize>(header.size()));
+  os.write(payload.data(), static_cast<std::streamsize>(payload.size()));
+  return static_cast<bool>(os);
+}
+
+// Reads the header and payload, then hands each decoded element to
+// append(Object&&) in ascending order. Returns false on any error.
+template <typename Object, typename Append>
+bool readBinary(std::istream& is, Append append) {
+  char header[6];
+  if (!is.read(header, sizeof(header)) || std::memcmp(header, kMagic, sizeof(kMagic)) != 0 ||
+    static_cast<unsigned char>(header[4]) != kVersion ||
+    static_cast<unsigned char>(header[5]) != elementKind<Object>())
+    return false;
+
+  // Every element takes at least one payload byte
+  std::uint64_t count, bytes;
+  if (!getVarint(is, count) || !getVarint(is, bytes) ||
+    count > static_cast<std::uint64_t>(std::numeric_limits<int>::max()) || count > bytes)
+    return false;
+
+  // The payload is read in chunks, so a header claiming more bytes than the
+  // stream holds fails once the stream runs dry instead of allocating the
+  // claimed size up front
+  const std::size_t kChunk = 1 << 16;
+  std::string payload;
+  try {
+    if (bytes > payload.max_size())
+      return false;
+    while (payload.size() < bytes) {
+      std::size_t done = payload.size();
+      std::size_t n = static_cast<std::size_t>(std::min<std::uint64_t>(bytes - done, kChunk));
+      payload.resize(done + n);
+      if (!is.read(&payload[done], static_cast<std::streamsize>(n)))
+        return false;
+    }
+  }
+  catch (const std::bad_alloc&) {
+    return false;
+  }
+  catch (const std::length_error&) {
+    return false;
+  }
+
+  const char* p = payload.data();
+  const char* end = p + payload.size();
+  Object item{};
+  Object prev{};
+  for (std::uint64_t i = 0; i < count; ++i) {
+    if (!decodeElement(p, end, item, i == 0 ? nullptr : &prev))
+      return false;
+    prev = item;
+    append(std::move(item));
+  }
+  return p == end;
+}
+
+// Buffered text writer for operator<<. Elements are formatted into a local
+// buffer (integers with std::to_chars) that is handed to the stream in large
+// blocks instead of one formatted insertion per element.
+class TextBuffer {
+public:
+  explicit TextBuffer(std::ostream& os)
+    : out(os), plain(os.flags() == (std::ios_base::dec | std::ios_base::skipws) && os.width() == 0) {
+    buffer.reserve(kCapacity);
+  }
+  ~TextBuffer() { flush(); }
+
+  void append(const char* text, std::size_t n) {
+    buffer.append(text, n);
+    if (buffer.size() >= kCapacity)
+      flush();
+  }
+
+  // Formats one element. Streams with non-default flags (hex, showpos, width)
+  // get the element through the stream itself so their formatting still applies.
+  template <typename Object>
+  void element(const Object& item) {
+    if constexpr (std::is_integral<Object>::value) {
+      if (plain) {
+        char digits[24];
+        std::to_chars_result r = std::to_chars(digits, digits + sizeof(digits), item);
+        append(digits, static_cast<std::size_t>(r.ptr - digits));
+        return;
+      }
+    }
+    else if constexpr (std::is_same<Object, std::string>::value) {
+      if (plain) {
+        append(item.data(), item.size());
+        return;
+      }
+    }
+    flush();
+    out << item;
+  }
+
+  void flush() {
+    if (!buffer.empty()) {
+      out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+      buffer.clear();
+    }
+  }
+
+private:
+  static const std::size_t kCapacity = 1 << 16;
+  std::ostream& out;
+  bool plain;              // Stream uses default formatting
+  std::string buffer;
+};
+
+} // namespace
 
 // ============================================================================
 // CORE METHODS IMPLEMENTATION
 // ============================================================================
 
 // Default Constructor
+// Initializes an empty list that allocates from the default memory resource.
+template <typename Object>
+SortedList<Object, LinkedLayout>::SortedList() : SortedList(std::pmr::get_default_resource()) {
+}
+
+// Arena Constructor
 // Initializes an empty list with a dummy header node whose next and prev are nullptr.
 // The header simplifies head insertions/removals by providing a consistent start node.
 template <typename Object>
-SortedList<Object>::SortedList() : listSize(0) {
-  header = new Node();       // Create dummy header node
-  header->next = nullptr;
-  header->prev = nullptr;
+SortedList<Object, LinkedLayout>::SortedList(std::pmr::memory_resource* resource)
+  : alloc(resource), listSize(0) {
+  header = createNode();     // Create dummy header node
 }
 
 // Destructor
 // Cleans up all dynamically allocated memory.
-// Removes all nodes and then deletes the dummy header.
+// Removes all nodes and then destroys the dummy header.
 template <typename Object>
-SortedList<Object>::~SortedList() {
+SortedList<Object, LinkedLayout>::~SortedList() {
   clear();
-  delete header;
+  destroyNode(header);
 }
 
 // Clear Method
 // Removes all data nodes from the list and resets to an empty state.
+// A monotonic arena ignores deallocation, so when the elements need no
+// destructor either the whole chain is dropped in one step; its memory is
+// reclaimed when the owner releases the arena.
 template <typename Object>
-void SortedList<Object>::clear() {
-  Node* current = header->next;
-  while (current != nullptr) {
-    Node* nextNode = current->next;
-    delete current;
-    current = nextNode;
+void SortedList<Object, LinkedLayout>::clear() {
+  if (!std::is_trivially_destructible<Object>::value ||
+      dynamic_cast<std::pmr::monotonic_buffer_resource*>(alloc.resource()) == nullptr) {
+    Node* current = header->next;
+    while (current != nullptr) {
+      Node* nextNode = current->next;
+      destroyNode(current);
+      current = nextNode;
+    }
   }
   header->next = nullptr;
   listSize = 0;
@@ -52,34 +331,44 @@ void SortedList<Object>::clear() {
 // ============================================================================
 
 // Helper method for deep copy
+// The source is already sorted, so each copy is appended at the tail in O(1)
+// instead of being searched into place. Callers pass an empty list.
 template <typename Object>
-void SortedList<Object>::copyFrom(const SortedList& other) {
+void SortedList<Object, LinkedLayout>::copyFrom(const SortedList& other) {
+  Node* tail = nullptr;
   Node* current = other.header->next;
   while (current != nullptr) {
-    insert(current->data);
+    tail = linkAfter(tail, createNode(current->data));
     current = current->next;
   }
 }
 
 // Copy Constructor
+// Like the standard pmr containers, a copy uses the default memory resource.
 template <typename Object>
-SortedList<Object>::SortedList(const SortedList& other) : SortedList() {
+SortedList<Object, LinkedLayout>::SortedList(const SortedList& other) : SortedList() {
+  copyFrom(other);
+}
+
+// Copy Constructor with explicit memory resource
+template <typename Object>
+SortedList<Object, LinkedLayout>::SortedList(const SortedList& other, std::pmr::memory_resource* resource)
+  : SortedList(resource) {
   copyFrom(other);
 }
 
 // Move Constructor
+// The new list adopts other's memory resource along with its nodes.
 template <typename Object>
-SortedList<Object>::SortedList(SortedList&& other) noexcept
-  : header(other.header), listSize(other.listSize) {
-  other.header = new Node();  // Give other a new dummy header
-  other.header->next = nullptr;
-  other.header->prev = nullptr;
+SortedList<Object, LinkedLayout>::SortedList(SortedList&& other) noexcept
+  : alloc(other.alloc), header(other.header), listSize(other.listSize) {
+  other.header = other.createNode();  // Give other a new dummy header
   other.listSize = 0;
 }
 
 // Copy Assignment Operator
 template <typename Object>
-SortedList<Object>& SortedList<Object>::operator=(const SortedList& rhs) {
+SortedList<Object, LinkedLayout>& SortedList<Object, LinkedLayout>::operator=(const SortedList& rhs) {
   if (this != &rhs) {
     clear();
     copyFrom(rhs);
@@ -88,25 +377,54 @@ SortedList<Object>& SortedList<Object>::operator=(const SortedList& rhs) {
 }
 
 // Move Assignment Operator
+// Nodes can only be stolen when both lists allocate from the same resource;
+// otherwise the elements are moved into new nodes from this list's resource.
+// Those are appended to a scratch list first, so if an allocation fails the
+// elements are moved back, both lists are left as they were and the
+// exception propagates.
 template <typename Object>
-SortedList<Object>& SortedList<Object>::operator=(SortedList&& rhs) noexcept {
-  if (this != &rhs) {
-    // 1. Clear current data nodes
+SortedList<Object, LinkedLayout>& SortedList<Object, LinkedLayout>::operator=(SortedList&& rhs) {
+  if (this == &rhs)
+    return *this;
+
+  if (alloc == rhs.alloc) {
+    // 1. Give rhs a new dummy header first (the only allocation)
+    Node* emptyHeader = rhs.createNode();
+
+    // 2. Release the current nodes and dummy header
     clear();
-    // 2. Delete the current dummy header to prevent leak
-    delete header;
+    destroyNode(header);
 
-    // 3. Steal resources from rhs
+    // 3. Steal resources from rhs and leave it a valid, empty list
     header = rhs.header;
     listSize = rhs.listSize;
-
-    // 4. Put rhs into a valid, empty state
-    // Leave rhs with a valid empty list
-    rhs.header = new Node();
-    rhs.header->next = nullptr;
-    rhs.header->prev = nullptr;
+    rhs.header = emptyHeader;
     rhs.listSize = 0;
   }
+  else {
+    SortedList scratch(alloc.resource());
+    Node* tail = nullptr;
+    Node* current = rhs.header->next;
+    try {
+      // rhs is sorted, so each element is appended at the tail in O(1)
+      while (current != nullptr) {
+        tail = scratch.linkAfter(tail, scratch.createNode(std::move(current->data)));
+        current = current->next;
+      }
+    }
+    catch (...) {
+      Node* source = rhs.header->next;
+      for (Node* moved = scratch.header->next; moved != nullptr; moved = moved->next) {
+        source->data = std::move(moved->data);
+        source = source->next;
+      }
+      throw;
+    }
+    clear();
+    std::swap(header, scratch.header);
+    std::swap(listSize, scratch.listSize);
+    rhs.clear();
+  }
   return *this;
 }
 
@@ -118,20 +436,92 @@ SortedList<Object>& SortedList<Object>::operator=(SortedList&& rhs) noexcept {
 // Finds the node *after which* a new item should be inserted to maintain sorted order.
 // Returns pointer to first node with data >= item, or nullptr if item is largest.
 template <typename Object>
-typename SortedList<Object>::Node*
-SortedList<Object>::findInsertPosition(const Object& item) const {
+typename SortedList<Object, LinkedLayout>::Node*
+SortedList<Object, LinkedLayout>::findInsertPosition(const Object& item) const {
+  KeyPrefix key;
+  key.assign(item);
   Node* current = header->next;
-  while (current != nullptr && current->data < item) {
+  while (current != nullptr && current->lessThan(key, item)) {
     current = current->next;
   }
   return current;  // may be nullptr if item is greater than all existing nodes
 }
 
+// Destroy Node Helper
+// Runs the node's destructor and returns its storage to the memory resource.
+template <typename Object>
+void SortedList<Object, LinkedLayout>::destroyNode(Node* p) {
+  p->~Node();
+  alloc.deallocate(p, 1);
+}
+
+// Link Node Helper
+// Links an already constructed node into the list while maintaining sorted order.
+// Comparisons go through the node's cached key, which it carries from construction.
+template <typename Object>
+void SortedList<Object, LinkedLayout>::linkNode(Node* newNode) {
+  const Object& item = newNode->data;
+  const KeyPrefix& key = *newNode;
+
+  // Case 1: Empty list
+  if (header->next == nullptr) {
+    header->next = newNode;
+    newNode->prev = nullptr;
+    listSize++;
+    return;
+  }
+
+  // Case 2: Insert at beginning (new item is smallest)
+  if (header->next->greaterThan(key, item)) {
+    newNode->next = header->next;
+    newNode->prev = nullptr;
+    header->next->prev = newNode;
+    header->next = newNode;
+    listSize++;
+    return;
+  }
+
+  // Case 3: Insert in middle or at end
+  Node* current = header->next;
+  while (current->next != nullptr && current->next->lessThan(key, item)) {
+    current = current->next;
+  }
+
+  // Insert after current
+  newNode->next = current->next;
+  newNode->prev = current;
+  if (current->next != nullptr) {
+    current->next->prev = newNode;
+  }
+  current->next = newNode;
+
+  listSize++;
+}
+
+// Link After Helper
+// Links newNode directly after tail, or at the front when tail is nullptr.
+// The caller guarantees the result stays sorted. Returns newNode.
+template <typename Object>
+typename SortedList<Object, LinkedLayout>::Node*
+SortedList<Object, LinkedLayout>::linkAfter(Node* tail, Node* newNode) {
+  Node* after = (tail == nullptr) ? header->next : tail->next;
+  newNode->prev = tail;
+  newNode->next = after;
+  if (after != nullptr)
+    after->prev = newNode;
+  if (tail == nullptr)
+    header->next = newNode;
+  else
+    tail->next = newNode;
+  listSize++;
+  return newNode;
+}
+
 // Remove Node Helper
 // Removes a specific node (already located) and updates adjacent pointers.
 // Handles the actual pointer manipulation and memory deallocation.
 template <typename Object>
-void SortedList<Object>::removeNode(Node* p) {
+void SortedList<Object, LinkedLayout>::removeNode(Node* p) {
   if (p == nullptr) return;
 
   // Update previous node's next pointer
@@ -148,7 +538,7 @@ void SortedList<Object>::removeNode(Node* p) {
     p->next->prev = p->prev;
   }
 
-  delete p;
+  destroyNode(p);
   listSize--;
 }
 
@@ -160,10 +550,12 @@ void SortedList<Object>::removeNode(Node* p) {
 // Searches for the first occurrence of an item and removes it if found.
 // Returns true if item was found and removed, false otherwise.
 template <typename Object>
-bool SortedList<Object>::remove(const Object& item) {
+bool SortedList<Object, LinkedLayout>::remove(const Object& item) {
+  KeyPrefix key;
+  key.assign(item);
   Node* current = header->next;
   while (current != nullptr) {
-    if (current->data == item) {
+    if (current->equals(key, item)) {
       // Found the node to remove
       removeNode(current);
       return true;
@@ -174,50 +566,17 @@ bool SortedList<Object>::remove(const Object& item) {
 }
 
 // Insert Method
-// Inserts an item into the list while maintaining sorted order.
+// Inserts a copy of an item into the list while maintaining sorted order.
 template <typename Object>
-bool SortedList<Object>::insert(const Object& item) {
-  try {
-    Node* newNode = new Node(item);
-
-    // Case 1: Empty list
-    if (header->next == nullptr) {
-      header->next = newNode;
-      newNode->prev = nullptr;
-      listSize++;
-      return true;
-    }
-
-    // Case 2: Insert at beginning (new item is smallest)
-    if (item < header->next->data) {
-      newNode->next = header->next;
-      newNode->prev = nullptr;
-      header->next->prev = newNode;
-      header->next = newNode;
-      listSize++;
-      return true;
-    }
-
-    // Case 3: Insert in middle or at end
-    Node* current = header->next;
-    while (current->next != nullptr && current->next->data < item) {
-      current = current->next;
-    }
-
-    // Insert after current
-    newNode->next = current->next;
-    newNode->prev = current;
-    if (current->next != nullptr) {
-      current->next->prev = newNode;
-    }
-    current->next = newNode;
+bool SortedList<Object, LinkedLayout>::insert(const Object& item) {
+  return emplace(item);
+}
 
-    listSize++;
-    return true;
-  }
-  catch (const std::bad_alloc&) {
-    return false;
-  }
+// Insert Method (move)
+// Moves an item into a new node, avoiding a copy of its contents.
+template <typename Object>
+bool SortedList<Object, LinkedLayout>::insert(Object&& item) {
+  return emplace(std::move(item));
 }
 
 // ============================================================================
@@ -226,7 +585,7 @@ bool SortedList<Object>::insert(const Object& item) {
 
 // Bracket Operator (Subscript)
 template <typename Object>
-const Object& SortedList<Object>::operator[](int index) const {
+const Object& SortedList<Object, LinkedLayout>::operator[](int index) const {
   if (index < 0 || index >= listSize)
     throw std::out_of_range("Index out of bounds in SortedList::operator[]");
 
@@ -238,8 +597,10 @@ const Object& SortedList<Object>::operator[](int index) const {
 }
 
 // Bracket Operator (Subscript) - Non-const
+// Returns a const reference for element types whose key is cached in the node.
 template <typename Object>
-Object& SortedList<Object>::operator[](int index) {
+typename SortedList<Object, LinkedLayout>::reference
+SortedList<Object, LinkedLayout>::operator[](int index) {
   if (index < 0 || index >= listSize)
     throw std::out_of_range("Index out of bounds in SortedList::operator[]");
 
@@ -252,8 +613,8 @@ Object& SortedList<Object>::operator[](int index) {
 
 // Addition Operator (Merge)
 template <typename Object>
-SortedList<Object> SortedList<Object>::operator+(const SortedList& rhs) const {
-  SortedList<Object> result = *this;
+SortedList<Object, LinkedLayout> SortedList<Object, LinkedLayout>::operator+(const SortedList& rhs) const {
+  SortedList<Object, LinkedLayout> result = *this;
   Node* current = rhs.header->next;
   while (current != nullptr) {
     result.insert(current->data);
@@ -264,14 +625,14 @@ SortedList<Object> SortedList<Object>::operator+(const SortedList& rhs) const {
 
 // Equality Operator
 template <typename Object>
-bool SortedList<Object>::operator==(const SortedList& sl) const {
+bool SortedList<Object, LinkedLayout>::operator==(const SortedList& sl) const {
   if (listSize != sl.listSize)
     return false;
 
   Node* currentThis = header->next;
   Node* currentSl = sl.header->next;
   while (currentThis != nullptr && currentSl != nullptr) {
-    if (!(currentThis->data == currentSl->data))
+    if (!currentThis->equals(*currentSl, currentSl->data))
       return false;
     currentThis = currentThis->next;
     currentSl = currentSl->next;
@@ -280,33 +641,719 @@ bool SortedList<Object>::operator==(const SortedList& sl) const {
   return currentThis == nullptr && currentSl == nullptr;
 }
 
+// ============================================================================
+// SERIALIZATION IMPLEMENTATION
+// ============================================================================
+
+// Save Binary Method
+template <typename Object>
+bool SortedList<Object, LinkedLayout>::saveBinary(std::ostream& os) const {
+  return writeBinary<Object>(os, static_cast<std::size_t>(listSize), [this](auto visit) {
+    for (Node* current = header->next; current != nullptr; current = current->next)
+      visit(current->data);
+    });
+}
+
+// Load Binary Method
+// The stream holds the elements in order, so each one is appended at the tail
+// of a scratch list (O(n) overall) that replaces this list on success.
+template <typename Object>
+bool SortedList<Object, LinkedLayout>::loadBinary(std::istream& is) {
+  try {
+    SortedList<Object, LinkedLayout> loaded(alloc.resource());
+    Node* tail = nullptr;
+    if (!readBinary<Object>(is, [&](Object&& item) {
+      tail = loaded.linkAfter(tail, loaded.createNode(std::move(item)));
+      }))
+      return false;
+    *this = std::move(loaded);
+    return true;
+  }
+  catch (const std::bad_alloc&) {
+    return false;
+  }
+}
+
 // ============================================================================
 // FRIEND FUNCTION IMPLEMENTATION
 // ============================================================================
 
 template <typename T>
-std::ostream& operator<<(std::ostream& os, const SortedList<T>& sl) {
-  typename SortedList<T>::Node* current = sl.header->next;
+std::ostream& operator<<(std::ostream& os, const SortedList<T, LinkedLayout>& sl) {
+  TextBuffer text(os);
+  typename SortedList<T, LinkedLayout>::Node* current = sl.header->next;
   bool first = true;
   while (current != nullptr) {
-    if (!first) os << ", ";
-    os << current->data;
+    if (!first) text.append(", ", 2);
+    text.element(current->data);
     first = false;
     current = current->next;
 
     // Safety check for infinite loops
     if (first == false && current == sl.header->next) {
-      os << " [CYCLE DETECTED!]";
+      text.append(" [CYCLE DETECTED!]", 18);
       break;
     }
   }
   return os;
 }
 
+// ============================================================================
+// CONTIGUOUS LAYOUT IMPLEMENTATION
+// ============================================================================
+
+namespace {
+
+// Width of the window that the binary search hands over to a linear scan.
+// Sixteen ints are one AVX2 pass pair or four SSE2 compares.
+const std::size_t kScanWidth = 16;
+
+// Counts the elements of p[0..len) that are less than item.
+// The range is sorted, so the count is the offset of the lower bound.
+template <typename Object>
+std::size_t countLess(const Object* p, std::size_t len, const Object& item) {
+  std::size_t count = 0;
+  for (std::size_t i = 0; i < len; ++i)
+    count += (p[i] < item) ? 1 : 0;
+  return count;
+}
+
+#if defined(__SSE2__)
+// SIMD version for int keys: compare four (or eight) keys per instruction
+// and subtract the all-ones lane masks from a running count.
+template <>
+std::size_t countLess<int>(const int* p, std::size_t len, const int& item) {
+  std::size_t i = 0;
+  std::size_t count = 0;
+#if defined(__AVX2__)
+  const __m256i key8 = _mm256_set1_epi32(item);
+  __m256i acc8 = _mm256_setzero_si256();
+  for (; i + 8 <= len; i += 8) {
+    __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+    acc8 = _mm256_sub_epi32(acc8, _mm256_cmpgt_epi32(key8, v));
+  }
+  alignas(32) int lanes8[8];
+  _mm256_store_si256(reinterpret_cast<__m256i*>(lanes8), acc8);
+  for (int lane : lanes8)
+    count += static_cast<std::size_t>(lane);
+#endif
+  const __m128i key4 = _mm_set1_epi32(item);
+  __m128i acc4 = _mm_setzero_si128();
+  for (; i + 4 <= len; i += 4) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+    acc4 = _mm_sub_epi32(acc4, _mm_cmplt_epi32(v, key4));
+  }
+  alignas(16) int lanes4[4];
+  _mm_store_si128(reinterpret_cast<__m128i*>(lanes4), acc4);
+  for (int lane : lanes4)
+    count += static_cast<std::size_t>(lane);
+  for (; i < len; ++i)
+    count += (p[i] < item) ? 1 : 0;
+  return count;
+}
+#endif
+
+} // namespace
+
+// Default Constructor
+template <typename Object>
+SortedList<Object, ContiguousLayout>::SortedList()
+  : items(std::pmr::get_default_resource()) {
+}
+
+// Arena Constructor
+template <typename Object>
+SortedList<Object, ContiguousLayout>::SortedList(std::pmr::memory_resource* resource)
+  : items(resource) {
+}
+
+// Copy Constructor
+// Like the standard pmr containers, a copy uses the default memory resource.
+template <typename Object>
+SortedList<Object, ContiguousLayout>::SortedList(const SortedList& other)
+  : items(other.items, std::pmr::get_default_resource()) {
+}
+
+// Copy Constructor with explicit memory resource
+template <typename Object>
+SortedList<Object, ContiguousLayout>::SortedList(const SortedList& other,
+  std::pmr::memory_resource* resource)
+  : items(other.items, resource) {
+}
+
+// Move Constructor
+// The new list adopts other's array and memory resource.
+template <typename Object>
+SortedList<Object, ContiguousLayout>::SortedList(SortedList&& other) noexcept
+  : items(std::move(other.items)) {
+  other.items.clear();
+}
+
+// Copy Assignment Operator
+template <typename Object>
+SortedList<Object, ContiguousLayout>&
+SortedList<Object, ContiguousLayout>::operator=(const SortedList& rhs) {
+  if (this != &rhs) {
+    items = rhs.items;
+  }
+  return *this;
+}
+
+// Move Assignment Operator
+// The vector steals the array when both resources match and copies otherwise;
+// the copy allocates from this list's resource, so it may throw
+// std::bad_alloc, in which case both arrays are left as they were.
+template <typename Object>
+SortedList<Object, ContiguousLayout>&
+SortedList<Object, ContiguousLayout>::operator=(SortedList&& rhs) {
+  if (this != &rhs) {
+    items = std::move(rhs.items);
+    rhs.items.clear();
+  }
+  return *this;
+}
+
+// Lower Bound Helper
+// Halves the range with a conditional add instead of a branch (compiles to cmov),
+// so the search has no mispredictions; the final window is counted with SIMD.
+template <typename Object>
+std::size_t SortedList<Object, ContiguousLayout>::lowerBound(const Object& item) const {
+  const Object* first = items.data();
+  std::size_t len = items.size();
+  while (len > kScanWidth) {
+    std::size_t half = len / 2;
+    first += (first[half - 1] < item) ? half : 0;
+    len -= half;
+  }
+  return static_cast<std::size_t>(first - items.data()) + countLess(first, len, item);
+}
+
+// Insert Value Helper
+// Grows the array by one, opens a gap at the lower bound with memmove, and
+// stores the value. A new key goes in front of any equal keys, as in the
+// linked layout.
+template <typename Object>
+void SortedList<Object, ContiguousLayout>::insertValue(const Object& value) {
+  const Object item = value;  // value may alias an element that is about to move
+  std::size_t pos = lowerBound(item);
+  std::size_t tail = items.size() - pos;
+  items.push_back(item);
+  Object* base = items.data();
+  std::memmove(static_cast<void*>(base + pos + 1), base + pos, tail * sizeof(Object));
+  base[pos] = item;
+}
+
+// Insert Method
+template <typename Object>
+bool SortedList<Object, ContiguousLayout>::insert(const Object& item) {
+  try {
+    insertValue(item);
+    return true;
+  }
+  catch (const std::bad_alloc&) {
+    return false;
+  }
+}
+
+// Insert Method (move)
+// A trivially copyable move is a copy, so this shares the copying path.
+template <typename Object>
+bool SortedList<Object, ContiguousLayout>::insert(Object&& item) {
+  return insert(static_cast<const Object&>(item));
+}
+
+// Remove Method
+// The first occurrence of an item in a sorted array sits at its lower bound.
+// The tail is closed up with memmove.
+template <typename Object>
+bool SortedList<Object, ContiguousLayout>::remove(const Object& item) {
+  std::size_t pos = lowerBound(item);
+  if (pos == items.size() || !(items[pos] == item))
+    return false;
+  Object* base = items.data();
+  std::memmove(static_cast<void*>(base + pos), base + pos + 1,
+    (items.size() - pos - 1) * sizeof(Object));
+  items.pop_back();
+  return true;
+}
+
+// Bracket Operator (Subscript)
+template <typename Object>
+const Object& SortedList<Object, ContiguousLayout>::operator[](int index) const {
+  if (index < 0 || index >= size())
+    throw std::out_of_range("Index out of bounds in SortedList::operator[]");
+  return items[index];
+}
+
+// Bracket Operator (Subscript) - Non-const
+template <typename Object>
+Object& SortedList<Object, ContiguousLayout>::operator[](int index) {
+  if (index < 0 || index >= size())
+    throw std::out_of_range("Index out of bounds in SortedList::operator[]");
+  return items[index];
+}
+
+// Addition Operator (Merge)
+// Both inputs are sorted, so a single linear merge builds the result.
+template <typename Object>
+SortedList<Object, ContiguousLayout>
+SortedList<Object, ContiguousLayout>::operator+(const SortedList& rhs) const {
+  SortedList<Object, ContiguousLayout> result;
+  result.items.resize(items.size() + rhs.items.size());
+  std::merge(items.begin(), items.end(), rhs.items.begin(), rhs.items.end(),
+    result.items.begin());
+  return result;
+}
+
+// Equality Operator
+template <typename Object>
+bool SortedList<Object, ContiguousLayout>::operator==(const SortedList& sl) const {
+  return items.size() == sl.items.size() &&
+    std::equal(items.begin(), items.end(), sl.items.begin());
+}
+
+// Save Binary Method (contiguous)
+template <typename Object>
+bool SortedList<Object, ContiguousLayout>::saveBinary(std::ostream& os) const {
+  return writeBinary<Object>(os, items.size(), [this](auto visit) {
+    for (const Object& item : items)
+      visit(item);
+    });
+}
+
+// Load Binary Method (contiguous)
+// Elements arrive sorted, so they are appended to a scratch array in O(n).
+template <typename Object>
+bool SortedList<Object, ContiguousLayout>::loadBinary(std::istream& is) {
+  try {
+    std::pmr::vector<Object> loaded(items.get_allocator());
+    if (!readBinary<Object>(is, [&](Object&& item) { loaded.push_back(item); }))
+      return false;
+    items.swap(loaded);
+    return true;
+  }
+  catch (const std::bad_alloc&) {
+    return false;
+  }
+}
+
+template <typename T>
+std::ostream& operator<<(std::ostream& os, const SortedList<T, ContiguousLayout>& sl) {
+  TextBuffer text(os);
+  bool first = true;
+  for (const T& item : sl.items) {
+    if (!first) text.append(", ", 2);
+    text.element(item);
+    first = false;
+  }
+  return os;
+}
+
+// ============================================================================
+// UNROLLED LAYOUT IMPLEMENTATION
+// ============================================================================
+// Blocks split when an insert overflows them and merge with a neighbour when a
+// remove leaves them under half full. Before splitting, a full block first
+// tries to pass one element to a neighbour with room, and appends past the
+// last block start a fresh block instead of splitting, which keeps blocks
+// densely filled for both random and ascending input.
+
+// Create Block Helper
+// Allocates an empty block and links it after the given block.
+template <typename Object, std::size_t B>
+typename SortedList<Object, UnrolledLayout<B>>::Block*
+SortedList<Object, UnrolledLayout<B>>::createBlock(Block* after) {
+  Block* b = alloc.allocate(1);
+  b->count = 0;
+  b->prev = after;
+  b->next = (after == nullptr) ? head : after->next;
+  if (b->next != nullptr)
+    b->next->prev = b;
+  else
+    tail = b;
+  if (after != nullptr)
+    after->next = b;
+  else
+    head = b;
+  return b;
+}
+
+// Destroy Block Helper
+// Unlinks a block and returns its storage to the memory resource.
+// The elements are trivially copyable, so no destructors need to run.
+template <typename Object, std::size_t B>
+void SortedList<Object, UnrolledLayout<B>>::destroyBlock(Block* b) {
+  if (b->prev != nullptr)
+    b->prev->next = b->next;
+  else
+    head = b->next;
+  if (b->next != nullptr)
+    b->next->prev = b->prev;
+  else
+    tail = b->prev;
+  alloc.deallocate(b, 1);
+}
+
+// Default Constructor
+template <typename Object, std::size_t B>
+SortedList<Object, UnrolledLayout<B>>::SortedList()
+  : SortedList(std::pmr::get_default_resource()) {
+}
+
+// Arena Constructor
+template <typename Object, std::size_t B>
+SortedList<Object, UnrolledLayout<B>>::SortedList(std::pmr::memory_resource* resource)
+  : alloc(resource), head(nullptr), tail(nullptr), listSize(0) {
+}
+
+// Destructor
+template <typename Object, std::size_t B>
+SortedList<Object, UnrolledLayout<B>>::~SortedList() {
+  clear();
+}
+
+// Clear Method
+// Costs one deallocation per block rather than per element.
+template <typename Object, std::size_t B>
+void SortedList<Object, UnrolledLayout<B>>::clear() {
+  while (head != nullptr)
+    destroyBlock(head);
+  listSize = 0;
+}
+
+// Helper method for deep copy
+template <typename Object, std::size_t B>
+void SortedList<Object, UnrolledLayout<B>>::copyFrom(const SortedList& other) {
+  for (const Block* b = other.head; b != nullptr; b = b->next)
+    for (int i = 0; i < b->count; ++i)
+      appendBack(b->items()[i]);
+}
+
+// Copy Constructor
+// Like the standard pmr containers, a copy uses the default memory resource.
+template <typename Object, std::size_t B>
+SortedList<Object, UnrolledLayout<B>>::SortedList(const SortedList& other) : SortedList() {
+  copyFrom(other);
+}
+
+// Copy Constructor with explicit memory resource
+template <typename Object, std::size_t B>
+SortedList<Object, UnrolledLayout<B>>::SortedList(const SortedList& other,
+  std::pmr::memory_resource* resource)
+  : SortedList(resource) {
+  copyFrom(other);
+}
+
+// Move Constructor
+// The new list adopts other's blocks and memory resource.
+template <typename Object, std::size_t B>
+SortedList<Object, UnrolledLayout<B>>::SortedList(SortedList&& other) noexcept
+  : alloc(other.alloc), head(other.head), tail(other.tail), listSize(other.listSize) {
+  other.head = nullptr;
+  other.tail = nullptr;
+  other.listSize = 0;
+}
+
+// Copy Assignment Operator
+template <typename Object, std::size_t B>
+SortedList<Object, UnrolledLayout<B>>&
+SortedList<Object, UnrolledLayout<B>>::operator=(const SortedList& rhs) {
+  if (this != &rhs) {
+    clear();
+    copyFrom(rhs);
+  }
+  return *this;
+}
+
+// Move Assignment Operator
+// Blocks can only be stolen when both lists allocate from the same resource;
+// otherwise the elements are copied into blocks from this list's resource.
+// Those are filled in a scratch list first, so if an allocation fails both
+// lists are left as they were and the exception propagates.
+template <typename Object, std::size_t B>
+SortedList<Object, UnrolledLayout<B>>&
+SortedList<Object, UnrolledLayout<B>>::operator=(SortedList&& rhs) {
+  if (this == &rhs)
+    return *this;
+
+  if (alloc == rhs.alloc) {
+    clear();
+    std::swap(head, rhs.head);
+    std::swap(tail, rhs.tail);
+    std::swap(listSize, rhs.listSize);
+  }
+  else {
+    SortedList scratch(alloc.resource());
+    scratch.copyFrom(rhs);
+    clear();
+    std::swap(head, scratch.head);
+    std::swap(tail, scratch.tail);
+    std::swap(listSize, scratch.listSize);
+    rhs.clear();
+  }
+  return *this;
+}
+
+// Find Block Helper
+// Walks the blocks comparing only their last elements, so a search touches
+// about n / B blocks instead of n nodes. Items past the second-to-last block
+// go straight to the tail, which keeps ascending input O(1) per insert.
+template <typename Object, std::size_t B>
+typename SortedList<Object, UnrolledLayout<B>>::Block*
+SortedList<Object, UnrolledLayout<B>>::findBlock(const Object& item) const {
+  if (tail->prev == nullptr || tail->prev->items()[tail->prev->count - 1] < item)
+    return tail;
+  for (Block* b = head; b != nullptr; b = b->next) {
+    if (!(b->items()[b->count - 1] < item))
+      return b;
+  }
+  return tail;
+}
+
+// Append Back Helper
+// Fills the last block and starts a new one when it is full.
+template <typename Object, std::size_t B>
+void SortedList<Object, UnrolledLayout<B>>::appendBack(const Object& value) {
+  if (tail == nullptr || tail->count == static_cast<int>(B))
+    createBlock(tail);
+  tail->items()[tail->count++] = value;
+  listSize++;
+}
+
+// Insert Value Helper
+// Finds the block and the position inside it with a linear scan, makes room
+// if the block is full, then shifts the block's tail up with memmove.
+template <typename Object, std::size_t B>
+void SortedList<Object, UnrolledLayout<B>>::insertValue(const Object& value) {
+  const Object item = value;  // value may alias an element that is about to move
+  if (head == nullptr) {
+    appendBack(item);
+    return;
+  }
+
+  Block* b = findBlock(item);
+  int pos = static_cast<int>(countLess(b->items(), static_cast<std::size_t>(b->count), item));
+
+  if (b->count == static_cast<int>(B)) {
+    if (pos == 0 && b->prev != nullptr && b->prev->count < static_cast<int>(B)) {
+      // The item sorts between the previous block and this one
+      b = b->prev;
+      pos = b->count;
+    }
+    else if (b == tail && pos == b->count) {
+      // Appending past the end: start a fresh block, leave this one full
+      b = createBlock(b);
+      pos = 0;
+    }
+    else if (b->next != nullptr && b->next->count < static_cast<int>(B)) {
+      // Pass this block's last element to the front of the next block
+      Block* n = b->next;
+      std::memmove(static_cast<void*>(n->items() + 1), n->items(), n->count * sizeof(Object));
+      n->items()[0] = b->items()[B - 1];
+      n->count++;
+      b->count--;
+    }
+    else if (b->prev != nullptr && b->prev->count < static_cast<int>(B)) {
+      // Pass this block's first element to the end of the previous block
+      Block* p = b->prev;
+      p->items()[p->count++] = b->items()[0];
+      std::memmove(static_cast<void*>(b->items()), b->items() + 1, (B - 1) * sizeof(Object));
+      b->count--;
+      pos--;
+    }
+    else {
+      // Both neighbours are full: split this block in half
+      Block* n = createBlock(b);
+      const int half = static_cast<int>(B / 2);
+      std::memcpy(static_cast<void*>(n->items()), b->items() + half, (B - half) * sizeof(Object));
+      n->count = static_cast<int>(B) - half;
+      b->count = half;
+      if (pos > half) {
+        b = n;
+        pos -= half;
+      }
+    }
+  }
+
+  Object* items = b->items();
+  std::memmove(static_cast<void*>(items + pos + 1), items + pos, (b->count - pos) * sizeof(Object));
+  items[pos] = item;
+  b->count++;
+  listSize++;
+}
+
+// Insert Method
+template <typename Object, std::size_t B>
+bool SortedList<Object, UnrolledLayout<B>>::insert(const Object& item) {
+  try {
+    insertValue(item);
+    return true;
+  }
+  catch (const std::bad_alloc&) {
+    return false;
+  }
+}
+
+// Insert Method (move)
+// A trivially copyable move is a copy, so this shares the copying path.
+template <typename Object, std::size_t B>
+bool SortedList<Object, UnrolledLayout<B>>::insert(Object&& item) {
+  return insert(static_cast<const Object&>(item));
+}
+
+// Remove Method
+// Closes the gap inside the block, then frees an emptied block or merges an
+// under-half-full block into a neighbour that has room for it.
+template <typename Object, std::size_t B>
+bool SortedList<Object, UnrolledLayout<B>>::remove(const Object& item) {
+  if (head == nullptr)
+    return false;
+  Block* b = findBlock(item);
+  int pos = static_cast<int>(countLess(b->items(), static_cast<std::size_t>(b->count), item));
+  if (pos == b->count || !(b->items()[pos] == item))
+    return false;
+
+  Object* items = b->items();
+  std::memmove(static_cast<void*>(items + pos), items + pos + 1, (b->count - pos - 1) * sizeof(Object));
+  b->count--;
+  listSize--;
+
+  if (b->count == 0) {
+    destroyBlock(b);
+  }
+  else if (b->count < static_cast<int>(B / 2)) {
+    if (b->next != nullptr && b->count + b->next->count <= static_cast<int>(B)) {
+      Block* n = b->next;
+      std::memcpy(static_cast<void*>(b->items() + b->count), n->items(), n->count * sizeof(Object));
+      b->count += n->count;
+      destroyBlock(n);
+    }
+    else if (b->prev != nullptr && b->prev->count + b->count <= static_cast<int>(B)) {
+      Block* p = b->prev;
+      std::memcpy(static_cast<void*>(p->items() + p->count), b->items(), b->count * sizeof(Object));
+      p->count += b->count;
+      destroyBlock(b);
+    }
+  }
+  return true;
+}
+
+// Bracket Operator (Subscript)
+// Skips whole blocks by their counts, then indexes inside the block.
+template <typename Object, std::size_t B>
+const Object& SortedList<Object, UnrolledLayout<B>>::operator[](int index) const {
+  if (index < 0 || index >= listSize)
+    throw std::out_of_range("Index out of bounds in SortedList::operator[]");
+
+  const Block* b = head;
+  while (index >= b->count) {
+    index -= b->count;
+    b = b->next;
+  }
+  return b->items()[index];
+}
+
+// Bracket Operator (Subscript) - Non-const
+template <typename Object, std::size_t B>
+Object& SortedList<Object, UnrolledLayout<B>>::operator[](int index) {
+  const SortedList& self = *this;
+  return const_cast<Object&>(self[index]);
+}
+
+// Addition Operator (Merge)
+// Both inputs are sorted, so one pass appends the smaller front element.
+template <typename Object, std::size_t B>
+SortedList<Object, UnrolledLayout<B>>
+SortedList<Object, UnrolledLayout<B>>::operator+(const SortedList& rhs) const {
+  SortedList<Object, UnrolledLayout<B>> result;
+  const Block* lb = head;
+  const Block* rb = rhs.head;
+  int li = 0;
+  int ri = 0;
+  while (lb != nullptr || rb != nullptr) {
+    bool takeRight = lb == nullptr ||
+      (rb != nullptr && rb->items()[ri] < lb->items()[li]);
+    if (takeRight) {
+      result.appendBack(rb->items()[ri]);
+      if (++ri == rb->count) { rb = rb->next; ri = 0; }
+    }
+    else {
+      result.appendBack(lb->items()[li]);
+      if (++li == lb->count) { lb = lb->next; li = 0; }
+    }
+  }
+  return result;
+}
+
+// Equality Operator
+template <typename Object, std::size_t B>
+bool SortedList<Object, UnrolledLayout<B>>::operator==(const SortedList& sl) const {
+  if (listSize != sl.listSize)
+    return false;
+
+  const Block* lb = head;
+  const Block* rb = sl.head;
+  int li = 0;
+  int ri = 0;
+  while (lb != nullptr && rb != nullptr) {
+    if (!(lb->items()[li] == rb->items()[ri]))
+      return false;
+    if (++li == lb->count) { lb = lb->next; li = 0; }
+    if (++ri == rb->count) { rb = rb->next; ri = 0; }
+  }
+  return lb == nullptr && rb == nullptr;
+}
+
+// Save Binary Method (unrolled)
+template <typename Object, std::size_t B>
+bool SortedList<Object, UnrolledLayout<B>>::saveBinary(std::ostream& os) const {
+  return writeBinary<Object>(os, static_cast<std::size_t>(listSize), [this](auto visit) {
+    for (const Block* b = head; b != nullptr; b = b->next)
+      for (int i = 0; i < b->count; ++i)
+        visit(b->items()[i]);
+    });
+}
+
+// Load Binary Method (unrolled)
+// Elements arrive sorted, so they fill full blocks of a scratch list in O(n).
+template <typename Object, std::size_t B>
+bool SortedList<Object, UnrolledLayout<B>>::loadBinary(std::istream& is) {
+  try {
+    SortedList<Object, UnrolledLayout<B>> loaded(alloc.resource());
+    if (!readBinary<Object>(is, [&](Object&& item) { loaded.appendBack(item); }))
+      return false;
+    *this = std::move(loaded);
+    return true;
+  }
+  catch (const std::bad_alloc&) {
+    return false;
+  }
+}
+
+template <typename T, std::size_t N>
+std::ostream& operator<<(std::ostream& os, const SortedList<T, UnrolledLayout<N>>& sl) {
+  TextBuffer text(os);
+  bool first = true;
+  for (auto b = sl.head; b != nullptr; b = b->next) {
+    for (int i = 0; i < b->count; ++i) {
+      if (!first) text.append(", ", 2);
+      text.element(b->items()[i]);
+      first = false;
+    }
+  }
+  return os;
+}
+
 // ============================================================================
 // EXPLICIT TEMPLATE INSTANTIATIONS
 // ============================================================================
+// SortedList<int> selects ContiguousLayout through DefaultSortedListLayout;
+// the linked int list stays available for comparison.
 template class SortedList<int>;
+template class SortedList<int, LinkedLayout>;
+template class SortedList<int, UnrolledLayout<>>;
 template class SortedList<std::string>;
 template std::ostream& operator<<(std::ostream& os, const SortedList<int>& sl);
+template std::ostream& operator<<(std::ostream& os, const SortedList<int, LinkedLayout>& sl);
+template std::ostream& operator<<(std::ostream& os, const SortedList<int, UnrolledLayout<>>& sl);
 template std::ostream& operator<<(std::ostream& os, const SortedList<std::string>& sl);
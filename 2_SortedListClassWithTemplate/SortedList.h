@@ -3,9 +3,20 @@
 
 
 // This header file defines a Sorted List Class with Template that maintains
-// elements in sorted order. It implements a linear doubly-linked list with
-// a dummy header node to simplify insertion and deletion operations.
-// The list terminates with nullptr pointers at both ends.
+// elements in sorted order. The storage layout is a second template parameter
+// chosen at compile time from the element type:
+//   - LinkedLayout: a linear doubly-linked list with a dummy header node to
+//     simplify insertion and deletion operations. The list terminates with
+//     nullptr pointers at both ends. Used for general element types.
+//   - ContiguousLayout: one sorted array searched with a branchless/SIMD
+//     lower_bound. Used for trivially copyable keys such as int.
+//   - UnrolledLayout<B>: a doubly-linked list of blocks that each hold up to
+//     B sorted elements. Opt-in for trivially copyable keys when inserts and
+//     removes in the middle of a large list must not shift the whole array.
+// All layouts expose the same interface and obtain their memory from a
+// std::pmr::memory_resource, so a list can draw from a monotonic or pooled
+// arena instead of the global heap. Lists can be saved to and loaded from a
+// compact binary format; loading rebuilds the list in O(n).
 
 #ifndef SORTEDLIST_H
 #define SORTEDLIST_H
@@ -14,31 +25,154 @@
 #include <string>
 #include <stdexcept>
 #include <algorithm>
+#include <memory_resource>
+#include <new>
+#include <utility>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
 
+// --- Storage Layouts ---
+struct LinkedLayout {};      // One heap node per element, linked both ways
+struct ContiguousLayout {};  // All elements in one sorted array
+template <std::size_t BlockSize = 64>
+struct UnrolledLayout {};    // Linked blocks of up to BlockSize elements
+
+// Layout selection trait: trivially copyable keys can be shifted with memmove,
+// so they are stored contiguously; everything else keeps the linked nodes.
+template <typename Object>
+struct DefaultSortedListLayout {
+  using type = typename std::conditional<std::is_trivially_copyable<Object>::value,
+    ContiguousLayout, LinkedLayout>::type;
+};
+
+template <typename Object, typename Layout = typename DefaultSortedListLayout<Object>::type>
+class SortedList;
+
+// --- Cached Comparison Keys ---
+// Linked nodes inherit from SortedListKeyPrefix<Object>, which may cache a
+// cheap summary of the element so most comparisons never touch the element
+// itself. The general version caches nothing (and costs nothing, being an
+// empty base) and simply forwards to the element's operators.
 template <typename Object>
-class SortedList {
+struct SortedListKeyPrefix {
+  static const bool cached = false;   // Elements may be edited in place
+
+  void assign(const Object&) {}
+
+  static bool less(const SortedListKeyPrefix&, const Object& a,
+    const SortedListKeyPrefix&, const Object& b) {
+    return a < b;
+  }
+
+  static bool equal(const SortedListKeyPrefix&, const Object& a,
+    const SortedListKeyPrefix&, const Object& b) {
+    return a == b;
+  }
+};
+
+// String keys cache their first 8 bytes as a big-endian integer (zero padded)
+// together with their length. Comparing two prefixes as integers orders the
+// strings the same way std::string does whenever the prefixes differ; on a
+// tie the length decides unless both strings run past 8 bytes, and only then
+// are the heap buffers compared (from byte 8 on).
+// The cache is filled when an element is inserted, so editing an element in
+// place would leave it stale: a list of strings only hands out const
+// references through operator[].
+template <>
+struct SortedListKeyPrefix<std::string> {
+  static const bool cached = true;
+
+  std::uint64_t prefix = 0;   // Bytes 0-7, most significant byte first
+  std::size_t length = 0;     // Full string length
+
+  void assign(const std::string& s) {
+    length = s.size();
+    std::size_t n = length < 8 ? length : 8;
+    prefix = 0;
+    for (std::size_t i = 0; i < n; ++i)
+      prefix |= static_cast<std::uint64_t>(static_cast<unsigned char>(s[i])) << (56 - 8 * i);
+  }
+
+  static bool less(const SortedListKeyPrefix& ka, const std::string& a,
+    const SortedListKeyPrefix& kb, const std::string& b) {
+    if (ka.prefix != kb.prefix)
+      return ka.prefix < kb.prefix;
+    if (ka.length <= 8 || kb.length <= 8)
+      return ka.length < kb.length;   // Shorter one is a prefix of the other
+    std::size_t n = (ka.length < kb.length ? ka.length : kb.length) - 8;
+    int tail = std::char_traits<char>::compare(a.data() + 8, b.data() + 8, n);
+    return tail != 0 ? tail < 0 : ka.length < kb.length;
+  }
+
+  static bool equal(const SortedListKeyPrefix& ka, const std::string& a,
+    const SortedListKeyPrefix& kb, const std::string& b) {
+    if (ka.prefix != kb.prefix || ka.length != kb.length)
+      return false;
+    return ka.length <= 8 ||
+      std::char_traits<char>::compare(a.data() + 8, b.data() + 8, ka.length - 8) == 0;
+  }
+};
+
+// ============================================================================
+// LINKED LAYOUT
+// ============================================================================
+
+template <typename Object>
+class SortedList<Object, LinkedLayout> {
 private:
+  using KeyPrefix = SortedListKeyPrefix<Object>;
+
   // Node structure for the doubly-linked linear list
-  // Each node contains data and pointers to both next and previous nodes.
-  struct Node {
+  // Each node contains data, its cached comparison key (the base class) and
+  // pointers to both next and previous nodes.
+  struct Node : KeyPrefix {
     Object data;        // The stored element
     Node* next;         // Pointer to the next node in the list
     Node* prev;         // Pointer to the previous node in the list
 
-    // Node constructor with default parameters
-    Node(const Object& d = Object{}, Node* p = nullptr, Node* n = nullptr)
-      : data{ d }, prev{ p }, next{ n } {
+    // Node constructor: builds the element in place from the given arguments
+    template <typename... Args>
+    explicit Node(Node* p, Node* n, Args&&... args)
+      : data(std::forward<Args>(args)...), next{ n }, prev{ p } {
+      this->assign(data);
+    }
+
+    // Comparisons through the cached key
+    bool lessThan(const KeyPrefix& key, const Object& item) const {
+      return KeyPrefix::less(*this, data, key, item);
+    }
+    bool greaterThan(const KeyPrefix& key, const Object& item) const {
+      return KeyPrefix::less(key, item, *this, data);
+    }
+    bool equals(const KeyPrefix& key, const Object& item) const {
+      return KeyPrefix::equal(*this, data, key, item);
     }
   };
 
+  std::pmr::polymorphic_allocator<Node> alloc; // Source of all nodes (incl. header)
   Node* header;         // Dummy header node (simplifies head insertion/removal)
   int listSize;         // Current number of elements in the list
 
+  // Helper methods to allocate/construct and destroy/deallocate a node
+  // through the list's memory resource
+  template <typename... Args>
+  Node* createNode(Args&&... args);
+  void destroyNode(Node* p);
+
+  // Helper method to link an already constructed node in sorted position
+  void linkNode(Node* newNode);
+
+  // Helper method to link a node directly after tail (nullptr = at the front).
+  // Used to bulk-build a list from input that is already sorted.
+  Node* linkAfter(Node* tail, Node* newNode);
+
   // Helper method to find correct insertion position to maintain sorted order
   // Returns a pointer to the node before which the new item should be inserted
   Node* findInsertPosition(const Object& item) const;
 
-  // Helper method for deep copy
+  // Helper method for deep copy into this (empty) list in O(n)
   void copyFrom(const SortedList& other);
 
   // Helper method to remove a specific node (already located)
@@ -49,8 +183,13 @@ public:
   // --- Core Methods ---
 
   // Default constructor: Creates an empty sorted list with a dummy header.
+  // Nodes come from the current default memory resource.
   SortedList();
 
+  // Arena constructor: Creates an empty list whose nodes are allocated from
+  // the given memory resource (which must outlive the list).
+  explicit SortedList(std::pmr::memory_resource* resource);
+
   // Destructor: Cleans up all dynamically allocated memory.
   ~SortedList();
 
@@ -59,16 +198,103 @@ public:
 
   // --- Rule of Five ---
   SortedList(const SortedList& other);         // Copy constructor
+  SortedList(const SortedList& other, std::pmr::memory_resource* resource);
   SortedList(SortedList&& other) noexcept;              // Move constructor
   SortedList& operator=(const SortedList& rhs);// Copy assignment
-  SortedList& operator=(SortedList&& rhs) noexcept;     // Move assignment
+  // Move assignment: may allocate (and throw std::bad_alloc) when the lists
+  // use different memory resources, like the standard pmr containers
+  SortedList& operator=(SortedList&& rhs);
 
   // --- Accessors ---
   int size() const { return listSize; }        // Returns number of elements
   bool empty() const { return size() == 0; }   // Returns true if list is empty
+  std::pmr::memory_resource* memoryResource() const { return alloc.resource(); }
+
+  // --- Mutators ---
+  bool insert(const Object& item);             // Insert item in sorted order
+  bool insert(Object&& item);                  // Insert by moving item in
+  template <typename... Args>
+  bool emplace(Args&&... args);                // Construct item in place, then insert
+  bool remove(const Object& item);             // Remove first occurrence of item
+
+  // --- Operators ---
+  // Element reference handed out by the non-const operator[]: const when the
+  // nodes cache a comparison key that an in-place edit would leave stale
+  using reference = typename std::conditional<KeyPrefix::cached, const Object&, Object&>::type;
+
+  reference operator[](int index); // Non-const access element by index
+  const Object& operator[](int index) const; // Const access element by index
+  SortedList operator+(const SortedList& rhs) const; // Merge two lists
+  bool operator==(const SortedList& sl) const; // Equality comparison
+  bool operator!=(const SortedList& sl) const { return !(*this == sl); }
+
+  // --- Serialization ---
+  // Writes the list in the binary format; returns false if the stream fails.
+  bool saveBinary(std::ostream& os) const;
+  // Replaces the contents with a list written by saveBinary. Returns false
+  // (leaving the list unchanged) on a stream error or malformed input.
+  bool loadBinary(std::istream& is);
+
+  // --- Friend Functions ---
+  template <typename T>
+  friend std::ostream& operator<<(std::ostream& os, const SortedList<T, LinkedLayout>& sl);
+};
+
+// ============================================================================
+// CONTIGUOUS LAYOUT
+// ============================================================================
+
+template <typename Object>
+class SortedList<Object, ContiguousLayout> {
+  static_assert(std::is_trivially_copyable<Object>::value,
+    "ContiguousLayout shifts elements with memmove and needs trivially copyable keys");
+
+private:
+  std::pmr::vector<Object> items;  // Elements in ascending order
+
+  // Helper method to find the index of the first element that is not less
+  // than item (branchless binary search, then a SIMD scan of the last window)
+  std::size_t lowerBound(const Object& item) const;
+
+  // Helper method to place a value at its sorted position
+  void insertValue(const Object& value);
+
+public:
+  // --- Core Methods ---
+
+  // Default constructor: Creates an empty sorted list.
+  // Storage comes from the current default memory resource.
+  SortedList();
+
+  // Arena constructor: Creates an empty list whose storage is allocated from
+  // the given memory resource (which must outlive the list).
+  explicit SortedList(std::pmr::memory_resource* resource);
+
+  // Destructor: Storage is released by the underlying vector.
+  ~SortedList() = default;
+
+  // Removes all elements from the list and resets to empty state.
+  void clear() { items.clear(); }
+
+  // --- Rule of Five ---
+  SortedList(const SortedList& other);         // Copy constructor
+  SortedList(const SortedList& other, std::pmr::memory_resource* resource);
+  SortedList(SortedList&& other) noexcept;              // Move constructor
+  SortedList& operator=(const SortedList& rhs);// Copy assignment
+  // Move assignment: may allocate (and throw std::bad_alloc) when the lists
+  // use different memory resources, like the standard pmr containers
+  SortedList& operator=(SortedList&& rhs);
+
+  // --- Accessors ---
+  int size() const { return static_cast<int>(items.size()); } // Returns number of elements
+  bool empty() const { return items.empty(); } // Returns true if list is empty
+  std::pmr::memory_resource* memoryResource() const { return items.get_allocator().resource(); }
 
   // --- Mutators ---
   bool insert(const Object& item);             // Insert item in sorted order
+  bool insert(Object&& item);                  // Insert by moving item in
+  template <typename... Args>
+  bool emplace(Args&&... args);                // Construct item, then insert
   bool remove(const Object& item);             // Remove first occurrence of item
 
   // --- Operators ---
@@ -78,9 +304,187 @@ public:
   bool operator==(const SortedList& sl) const; // Equality comparison
   bool operator!=(const SortedList& sl) const { return !(*this == sl); }
 
+  // --- Serialization ---
+  // Writes the list in the binary format; returns false if the stream fails.
+  bool saveBinary(std::ostream& os) const;
+  // Replaces the contents with a list written by saveBinary. Returns false
+  // (leaving the list unchanged) on a stream error or malformed input.
+  bool loadBinary(std::istream& is);
+
   // --- Friend Functions ---
   template <typename T>
-  friend std::ostream& operator<<(std::ostream& os, const SortedList<T>& sl);
+  friend std::ostream& operator<<(std::ostream& os, const SortedList<T, ContiguousLayout>& sl);
+};
+
+// ============================================================================
+// UNROLLED LAYOUT
+// ============================================================================
+
+template <typename Object, std::size_t B>
+class SortedList<Object, UnrolledLayout<B>> {
+  static_assert(std::is_trivially_copyable<Object>::value,
+    "UnrolledLayout shifts elements with memmove and needs trivially copyable keys");
+  static_assert(B >= 4, "UnrolledLayout blocks need room for at least 4 elements");
+
+private:
+  // Block structure for the unrolled list
+  // Each block holds a sorted run of count elements (1 <= count <= B) in raw
+  // storage, plus pointers to the neighbouring blocks. Every element of a
+  // block is <= every element of the next block.
+  struct Block {
+    Block* next;        // Pointer to the next block in the list
+    Block* prev;        // Pointer to the previous block in the list
+    int count;          // Number of elements in use
+    alignas(Object) unsigned char storage[B * sizeof(Object)];
+
+    Object* items() { return reinterpret_cast<Object*>(storage); }
+    const Object* items() const { return reinterpret_cast<const Object*>(storage); }
+  };
+
+  std::pmr::polymorphic_allocator<Block> alloc; // Source of all blocks
+  Block* head;          // First block (nullptr when empty)
+  Block* tail;          // Last block (nullptr when empty)
+  int listSize;         // Current number of elements in the list
+
+  // Helper methods to create an empty block linked after the given block
+  // (nullptr = at the front) and to unlink and free a block
+  Block* createBlock(Block* after);
+  void destroyBlock(Block* b);
+
+  // Helper method to find the first block whose last element is not less
+  // than item; that block holds item's lower bound (tail if none does)
+  Block* findBlock(const Object& item) const;
+
+  // Helper method to place a value at its sorted position
+  void insertValue(const Object& value);
+
+  // Helper method to append a value known to be >= every element (O(1))
+  void appendBack(const Object& value);
+
+  // Helper method for deep copy into this (empty) list in O(n)
+  void copyFrom(const SortedList& other);
+
+public:
+  // --- Core Methods ---
+
+  // Default constructor: Creates an empty sorted list.
+  // Blocks come from the current default memory resource.
+  SortedList();
+
+  // Arena constructor: Creates an empty list whose blocks are allocated from
+  // the given memory resource (which must outlive the list).
+  explicit SortedList(std::pmr::memory_resource* resource);
+
+  // Destructor: Frees every block.
+  ~SortedList();
+
+  // Removes all elements from the list and resets to empty state.
+  void clear();
+
+  // --- Rule of Five ---
+  SortedList(const SortedList& other);         // Copy constructor
+  SortedList(const SortedList& other, std::pmr::memory_resource* resource);
+  SortedList(SortedList&& other) noexcept;              // Move constructor
+  SortedList& operator=(const SortedList& rhs);// Copy assignment
+  // Move assignment: may allocate (and throw std::bad_alloc) when the lists
+  // use different memory resources, like the standard pmr containers
+  SortedList& operator=(SortedList&& rhs);
+
+  // --- Accessors ---
+  int size() const { return listSize; }        // Returns number of elements
+  bool empty() const { return size() == 0; }   // Returns true if list is empty
+  std::pmr::memory_resource* memoryResource() const { return alloc.resource(); }
+
+  // --- Mutators ---
+  bool insert(const Object& item);             // Insert item in sorted order
+  bool insert(Object&& item);                  // Insert by moving item in
+  template <typename... Args>
+  bool emplace(Args&&... args);                // Construct item, then insert
+  bool remove(const Object& item);             // Remove first occurrence of item
+
+  // --- Operators ---
+  Object& operator[](int index); // Non-const access element by index
+  const Object& operator[](int index) const; // Const access element by index
+  SortedList operator+(const SortedList& rhs) const; // Merge two lists
+  bool operator==(const SortedList& sl) const; // Equality comparison
+  bool operator!=(const SortedList& sl) const { return !(*this == sl); }
+
+  // --- Serialization ---
+  // Writes the list in the binary format; returns false if the stream fails.
+  bool saveBinary(std::ostream& os) const;
+  // Replaces the contents with a list written by saveBinary. Returns false
+  // (leaving the list unchanged) on a stream error or malformed input.
+  bool loadBinary(std::istream& is);
+
+  // --- Friend Functions ---
+  template <typename T, std::size_t N>
+  friend std::ostream& operator<<(std::ostream& os, const SortedList<T, UnrolledLayout<N>>& sl);
 };
 
+// ============================================================================
+// MEMBER TEMPLATES
+// ============================================================================
+// Defined here rather than in SortedList.cpp because they are instantiated per
+// argument list at the call site, not by the explicit instantiations.
+
+// Create Node Helper
+// Allocates raw storage from the memory resource and constructs the node in it.
+// If the element constructor throws, the storage is handed back before rethrowing.
+template <typename Object>
+template <typename... Args>
+typename SortedList<Object, LinkedLayout>::Node*
+SortedList<Object, LinkedLayout>::createNode(Args&&... args) {
+  Node* p = alloc.allocate(1);
+  try {
+    ::new (static_cast<void*>(p)) Node(nullptr, nullptr, std::forward<Args>(args)...);
+  }
+  catch (...) {
+    alloc.deallocate(p, 1);
+    throw;
+  }
+  return p;
+}
+
+// Emplace Method
+// Constructs the element directly inside a new node, then links it in sorted order.
+// Returns false if memory for the node could not be obtained.
+template <typename Object>
+template <typename... Args>
+bool SortedList<Object, LinkedLayout>::emplace(Args&&... args) {
+  try {
+    linkNode(createNode(std::forward<Args>(args)...));
+    return true;
+  }
+  catch (const std::bad_alloc&) {
+    return false;
+  }
+}
+
+// Emplace Method (contiguous)
+// Keys are trivially copyable, so the value is built once and then shifted in.
+template <typename Object>
+template <typename... Args>
+bool SortedList<Object, ContiguousLayout>::emplace(Args&&... args) {
+  try {
+    insertValue(Object(std::forward<Args>(args)...));
+    return true;
+  }
+  catch (const std::bad_alloc&) {
+    return false;
+  }
+}
+
+// Emplace Method (unrolled)
+template <typename Object, std::size_t B>
+template <typename... Args>
+bool SortedList<Object, UnrolledLayout<B>>::emplace(Args&&... args) {
+  try {
+    insertValue(Object(std::forward<Args>(args)...));
+    return true;
+  }
+  catch (const std::bad_alloc&) {
+    return false;
+  }
+}
+
 #endif // SORTEDLIST_H
\ No newline at end of file
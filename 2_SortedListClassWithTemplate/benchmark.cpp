@@ -0,0 +1,352 @@
+// benchmark.cpp
+// Scott Elliott
+
+// Comparative benchmark for the SortedList template class.
+// Runs SortedList<int> (contiguous layout), SortedList<int, LinkedLayout>,
+// SortedList<int, UnrolledLayout<>> and SortedList<std::string> against std::set, std::multiset and a sorted
+// std::vector on the same workloads:
+//   insert_random     build a container from n random keys
+//   insert_ascending  build a container from n keys in ascending order
+//   remove            remove up to 1000 random present keys
+//   index             read up to 1000 random positions (begin() + i for sets)
+//   merge             combine two containers of n/2 keys (operator+ for SortedList)
+//   copy              copy-construct a container of n keys
+// Sizes sweep from 10^2 to 10^maxExponent. Each result is reported as one JSON
+// object with ns per operation and, for the insert workloads, heap bytes per
+// element (requested bytes plus a 16-byte allocator header per allocation).
+// A (container, workload) pair stops growing once its next run is predicted to
+// exceed the time budget, so the quadratic containers drop out early.
+//
+// Compilation: g++ -std=c++17 -O2 benchmark.cpp SortedList.cpp -o benchmark
+// Execution:   ./benchmark [maxExponent] [budgetSeconds] > results.json
+//              (defaults: 7, 5)
+
+#include "SortedList.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <new>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+// ============================================================================
+// HEAP ACCOUNTING
+// ============================================================================
+// Global operator new/delete keep a running total of live heap bytes. Each
+// block carries a 16-byte header with its size, which also stands in for the
+// per-allocation overhead of a typical malloc.
+
+namespace {
+const std::size_t kHeader = 16;
+std::size_t liveBytes = 0;
+}
+
+void* operator new(std::size_t size) {
+  void* raw = std::malloc(size + kHeader);
+  if (raw == nullptr) throw std::bad_alloc();
+  *static_cast<std::size_t*>(raw) = size;
+  liveBytes += size + kHeader;
+  return static_cast<char*>(raw) + kHeader;
+}
+
+void operator delete(void* p) noexcept {
+  if (p == nullptr) return;
+  // Integer arithmetic keeps the optimizer from treating p as its element type
+  void* raw = reinterpret_cast<void*>(reinterpret_cast<std::uintptr_t>(p) - kHeader);
+  liveBytes -= *static_cast<std::size_t*>(raw) + kHeader;
+  std::free(raw);
+}
+
+// Over-aligned requests (std::pmr::new_delete_resource always passes an
+// alignment) keep the size header just below the aligned block.
+void* operator new(std::size_t size, std::align_val_t al) {
+  std::size_t align = std::max(static_cast<std::size_t>(al), kHeader);
+  std::size_t total = (size + align + align - 1) / align * align;
+  void* raw = std::aligned_alloc(align, total);
+  if (raw == nullptr) throw std::bad_alloc();
+  char* p = static_cast<char*>(raw) + align;
+  *reinterpret_cast<std::size_t*>(p - kHeader) = size;
+  liveBytes += size + kHeader;
+  return p;
+}
+
+void operator delete(void* p, std::align_val_t al) noexcept {
+  if (p == nullptr) return;
+  std::size_t align = std::max(static_cast<std::size_t>(al), kHeader);
+  char* cp = static_cast<char*>(p);
+  liveBytes -= *reinterpret_cast<std::size_t*>(cp - kHeader) + kHeader;
+  std::free(cp - align);
+}
+
+void operator delete(void* p, std::size_t, std::align_val_t al) noexcept { operator delete(p, al); }
+void* operator new[](std::size_t size) { return operator new(size); }
+void operator delete[](void* p) noexcept { operator delete(p); }
+void operator delete(void* p, std::size_t) noexcept { operator delete(p); }
+void operator delete[](void* p, std::size_t) noexcept { operator delete(p); }
+
+namespace {
+
+// ============================================================================
+// KEYS
+// ============================================================================
+
+template <typename Key> Key makeKey(long long v);
+
+template <> int makeKey<int>(long long v) { return static_cast<int>(v); }
+
+// Zero-padded so that string order matches numeric order
+template <> std::string makeKey<std::string>(long long v) {
+  char buf[24];
+  std::snprintf(buf, sizeof(buf), "key%012lld", v);
+  return buf;
+}
+
+template <typename Key>
+std::vector<Key> randomKeys(std::size_t n, unsigned seed) {
+  std::mt19937_64 gen(seed);
+  std::uniform_int_distribution<long long> dist(0, 1000000000LL);
+  std::vector<Key> keys;
+  keys.reserve(n);
+  for (std::size_t i = 0; i < n; ++i)
+    keys.push_back(makeKey<Key>(dist(gen)));
+  return keys;
+}
+
+template <typename Key>
+std::vector<Key> ascendingKeys(std::size_t n) {
+  std::vector<Key> keys;
+  keys.reserve(n);
+  for (std::size_t i = 0; i < n; ++i)
+    keys.push_back(makeKey<Key>(static_cast<long long>(i)));
+  return keys;
+}
+
+// ============================================================================
+// CONTAINER ADAPTERS
+// ============================================================================
+// Each adapter exposes the same five operations so one set of workloads can
+// drive every container.
+
+template <typename List>
+struct SortedListOps {
+  using Container = List;
+  template <typename Key> static void insert(Container& c, const Key& k) { c.insert(k); }
+  template <typename Key> static void remove(Container& c, const Key& k) { c.remove(k); }
+  static std::size_t size(const Container& c) { return static_cast<std::size_t>(c.size()); }
+  static const auto& at(const Container& c, std::size_t i) { return c[static_cast<int>(i)]; }
+  static Container merge(const Container& a, const Container& b) { return a + b; }
+};
+
+template <typename Set>
+struct SetOps {
+  using Container = Set;
+  template <typename Key> static void insert(Container& c, const Key& k) { c.insert(k); }
+  template <typename Key> static void remove(Container& c, const Key& k) {
+    auto it = c.find(k);
+    if (it != c.end()) c.erase(it);
+  }
+  static std::size_t size(const Container& c) { return c.size(); }
+  static const auto& at(const Container& c, std::size_t i) { return *std::next(c.begin(), i); }
+  static Container merge(const Container& a, const Container& b) {
+    Container result = a;
+    result.insert(b.begin(), b.end());
+    return result;
+  }
+};
+
+template <typename Key>
+struct VectorOps {
+  using Container = std::vector<Key>;
+  static void insert(Container& c, const Key& k) {
+    c.insert(std::lower_bound(c.begin(), c.end(), k), k);
+  }
+  static void remove(Container& c, const Key& k) {
+    auto it = std::lower_bound(c.begin(), c.end(), k);
+    if (it != c.end() && *it == k) c.erase(it);
+  }
+  static std::size_t size(const Container& c) { return c.size(); }
+  static const Key& at(const Container& c, std::size_t i) { return c[i]; }
+  static Container merge(const Container& a, const Container& b) {
+    Container result(a.size() + b.size());
+    std::merge(a.begin(), a.end(), b.begin(), b.end(), result.begin());
+    return result;
+  }
+};
+
+// ============================================================================
+// WORKLOADS
+// ============================================================================
+
+using Clock = std::chrono::steady_clock;
+
+struct Result {
+  double nsPerOp;      // seconds / operations, in nanoseconds
+  double bytesPerElem; // Heap bytes per element, or < 0 if not measured
+};
+
+double since(Clock::time_point start) {
+  return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// Sink for values read by the index workload so the reads are not optimized out
+std::size_t checksum = 0;
+void consume(int v) { checksum += static_cast<std::size_t>(v); }
+void consume(const std::string& v) { checksum += v.size(); }
+
+template <typename Ops, typename Key>
+typename Ops::Container build(const std::vector<Key>& keys) {
+  typename Ops::Container c;
+  for (const Key& k : keys)
+    Ops::insert(c, k);
+  return c;
+}
+
+template <typename Ops, typename Key>
+Result runInsert(const std::vector<Key>& keys) {
+  std::size_t before = liveBytes;
+  Clock::time_point start = Clock::now();
+  typename Ops::Container c = build<Ops>(keys);
+  double s = since(start);
+  double bytes = static_cast<double>(liveBytes - before) / keys.size();
+  return { s * 1e9 / keys.size(), bytes };
+}
+
+const std::size_t kProbeOps = 1000;
+
+template <typename Ops, typename Key>
+Result runRemove(const std::vector<Key>& keys) {
+  typename Ops::Container c = build<Ops>(keys);
+  std::size_t ops = std::min(kProbeOps, keys.size());
+  Clock::time_point start = Clock::now();
+  for (std::size_t i = 0; i < ops; ++i)
+    Ops::remove(c, keys[i]);
+  double s = since(start);
+  return { s * 1e9 / ops, -1 };
+}
+
+template <typename Ops, typename Key>
+Result runIndex(const std::vector<Key>& keys) {
+  typename Ops::Container c = build<Ops>(keys);
+  std::size_t ops = std::min(kProbeOps, keys.size());
+  std::mt19937 gen(5);
+  std::uniform_int_distribution<std::size_t> pos(0, Ops::size(c) - 1);
+  Clock::time_point start = Clock::now();
+  for (std::size_t i = 0; i < ops; ++i)
+    consume(Ops::at(c, pos(gen)));
+  double s = since(start);
+  return { s * 1e9 / ops, -1 };
+}
+
+template <typename Ops, typename Key>
+Result runMerge(const std::vector<Key>& keys) {
+  std::size_t half = keys.size() / 2;
+  typename Ops::Container a = build<Ops>(std::vector<Key>(keys.begin(), keys.begin() + half));
+  typename Ops::Container b = build<Ops>(std::vector<Key>(keys.begin() + half, keys.end()));
+  Clock::time_point start = Clock::now();
+  typename Ops::Container merged = Ops::merge(a, b);
+  double s = since(start);
+  return { s * 1e9 / keys.size(), -1 };
+}
+
+template <typename Ops, typename Key>
+Result runCopy(const std::vector<Key>& keys) {
+  typename Ops::Container c = build<Ops>(keys);
+  Clock::time_point start = Clock::now();
+  typename Ops::Container copy(c);
+  double s = since(start);
+  return { s * 1e9 / keys.size(), -1 };
+}
+
+// ============================================================================
+// SWEEP AND REPORTING
+// ============================================================================
+
+bool firstRecord = true;
+
+void report(const std::string& container, const std::string& key,
+  const std::string& workload, std::size_t n, const Result& r) {
+  std::cout << (firstRecord ? "  " : ",\n  ")
+    << "{\"container\": \"" << container << "\", \"key\": \"" << key
+    << "\", \"workload\": \"" << workload << "\", \"n\": " << n
+    << ", \"ns_per_op\": " << r.nsPerOp;
+  if (r.bytesPerElem >= 0)
+    std::cout << ", \"bytes_per_element\": " << r.bytesPerElem;
+  std::cout << "}";
+  firstRecord = false;
+}
+
+// Runs one workload over the size sweep. The next size is skipped when the
+// last run (including its setup), scaled by the growth seen between the last
+// two runs, would exceed the budget.
+template <typename Key>
+void sweep(const std::string& container, const std::string& key, const std::string& workload,
+  const std::function<Result(const std::vector<Key>&)>& run,
+  bool ascending, int maxExponent, double budget) {
+  double prevSeconds = 0;
+  double lastSeconds = 0;
+  std::size_t n = 100;
+  for (int e = 2; e <= maxExponent; ++e, n *= 10) {
+    if (lastSeconds > 0) {
+      double growth = prevSeconds > 0 ? std::max(10.0, lastSeconds / prevSeconds) : 100.0;
+      if (lastSeconds * growth > budget) {
+        std::cerr << "  skip " << container << " " << workload << " from n=" << n << std::endl;
+        return;
+      }
+    }
+    std::vector<Key> keys = ascending ? ascendingKeys<Key>(n) : randomKeys<Key>(n, 42);
+    Clock::time_point start = Clock::now();
+    Result r = run(keys);
+    report(container, key, workload, n, r);
+    prevSeconds = lastSeconds;
+    lastSeconds = since(start);
+  }
+}
+
+template <typename Ops, typename Key>
+void benchContainer(const std::string& container, const std::string& key,
+  int maxExponent, double budget) {
+  std::cerr << "Benchmarking " << container << "<" << key << ">" << std::endl;
+  sweep<Key>(container, key, "insert_random", runInsert<Ops, Key>, false, maxExponent, budget);
+  sweep<Key>(container, key, "insert_ascending", runInsert<Ops, Key>, true, maxExponent, budget);
+  sweep<Key>(container, key, "remove", runRemove<Ops, Key>, false, maxExponent, budget);
+  sweep<Key>(container, key, "index", runIndex<Ops, Key>, false, maxExponent, budget);
+  sweep<Key>(container, key, "merge", runMerge<Ops, Key>, false, maxExponent, budget);
+  sweep<Key>(container, key, "copy", runCopy<Ops, Key>, false, maxExponent, budget);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+  int maxExponent = 7;
+  double budget = 5.0;
+  if (argc > 1) maxExponent = std::atoi(argv[1]);
+  if (argc > 2) budget = std::atof(argv[2]);
+  if (maxExponent < 2 || budget <= 0) {
+    std::cerr << "Usage: " << argv[0] << " [maxExponent >= 2] [budgetSeconds > 0]" << std::endl;
+    return 1;
+  }
+
+  std::cout << "[\n";
+  benchContainer<SortedListOps<SortedList<int>>, int>("SortedList", "int", maxExponent, budget);
+  benchContainer<SortedListOps<SortedList<int, LinkedLayout>>, int>("SortedList<LinkedLayout>", "int", maxExponent, budget);
+  benchContainer<SortedListOps<SortedList<int, UnrolledLayout<>>>, int>("SortedList<UnrolledLayout>", "int", maxExponent, budget);
+  benchContainer<SetOps<std::set<int>>, int>("std::set", "int", maxExponent, budget);
+  benchContainer<SetOps<std::multiset<int>>, int>("std::multiset", "int", maxExponent, budget);
+  benchContainer<VectorOps<int>, int>("sorted std::vector", "int", maxExponent, budget);
+
+  benchContainer<SortedListOps<SortedList<std::string>>, std::string>("SortedList", "string", maxExponent, budget);
+  benchContainer<SetOps<std::set<std::string>>, std::string>("std::set", "string", maxExponent, budget);
+  benchContainer<SetOps<std::multiset<std::string>>, std::string>("std::multiset", "string", maxExponent, budget);
+  benchContainer<VectorOps<std::string>, std::string>("sorted std::vector", "string", maxExponent, budget);
+  std::cout << "\n]" << std::endl;
+
+  std::cerr << "checksum " << checksum << std::endl;
+  return 0;
+}
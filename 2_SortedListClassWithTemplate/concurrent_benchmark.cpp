@@ -0,0 +1,137 @@
+// concurrent_benchmark.cpp
+// Scott Elliott
+
+// Throughput benchmark for ConcurrentSortedList.
+// Compares the lock-free skip list against the setup it replaces: one big
+// std::mutex around an ordered container (std::set<int>, which unlike
+// SortedList has a lookup for the read side). For every thread count (powers of two
+// up to the limit) and every read/write mix, each thread runs a random mix of
+// contains / insert / remove over a shared key range for a fixed time, and the
+// total operations per second are reported. A scalable list shows throughput
+// rising with the thread count; the mutex version stays flat or drops.
+//
+// Compilation: g++ -std=c++17 -O2 -pthread concurrent_benchmark.cpp ConcurrentSortedList.cpp -o concurrent_benchmark
+// Execution:   ./concurrent_benchmark [maxThreads] [millisecondsPerRun]
+//              (defaults: hardware threads, 500 ms)
+
+#include "ConcurrentSortedList.h"
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace {
+
+const int kKeyRange = 1 << 16;   // Keys drawn uniformly from [0, kKeyRange)
+
+// Runs `threads` workers for `millis` ms. readPercent of the operations are
+// contains, the rest split evenly between insert and remove so the size stays
+// near half the key range. Returns total operations per second.
+template <typename Contains, typename Insert, typename Remove>
+double runMix(int threads, int millis, int readPercent,
+  Contains contains, Insert insert, Remove remove) {
+  std::atomic<bool> start{ false };
+  std::atomic<bool> stop{ false };
+  std::vector<long long> counts(threads, 0);
+  std::vector<std::thread> workers;
+
+  for (int t = 0; t < threads; ++t) {
+    workers.emplace_back([&, t]() {
+      std::mt19937 gen(1234 + t);
+      std::uniform_int_distribution<int> key(0, kKeyRange - 1);
+      std::uniform_int_distribution<int> op(0, 99);
+      long long done = 0;
+      while (!start.load(std::memory_order_acquire)) {
+      }
+      while (!stop.load(std::memory_order_relaxed)) {
+        for (int i = 0; i < 64; ++i) {
+          int k = key(gen);
+          int o = op(gen);
+          if (o < readPercent)
+            contains(k);
+          else if ((o - readPercent) % 2 == 0)
+            insert(k);
+          else
+            remove(k);
+        }
+        done += 64;
+      }
+      counts[t] = done;
+      });
+  }
+
+  auto begin = std::chrono::steady_clock::now();
+  start.store(true, std::memory_order_release);
+  std::this_thread::sleep_for(std::chrono::milliseconds(millis));
+  stop.store(true, std::memory_order_relaxed);
+  for (std::thread& w : workers)
+    w.join();
+  double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+  long long total = 0;
+  for (long long c : counts)
+    total += c;
+  return total / seconds;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+  int maxThreads = static_cast<int>(std::thread::hardware_concurrency());
+  if (maxThreads <= 0) maxThreads = 1;
+  int millis = 500;
+  if (argc > 1) maxThreads = std::atoi(argv[1]);
+  if (argc > 2) millis = std::atoi(argv[2]);
+  if (maxThreads <= 0 || millis <= 0) {
+    std::cerr << "Usage: " << argv[0] << " [maxThreads] [millisecondsPerRun]" << std::endl;
+    return 1;
+  }
+
+  const int readMixes[] = { 50, 90, 99 };
+
+  std::cout << "=== ConcurrentSortedList throughput (Mops/s), keys in [0, "
+    << kKeyRange << ") ===" << std::endl;
+  std::cout << std::setw(8) << "threads" << std::setw(8) << "reads%"
+    << std::setw(14) << "lock-free" << std::setw(14) << "mutex+set"
+    << std::setw(10) << "speedup" << std::endl;
+
+  std::vector<int> threadCounts;
+  for (int threads = 1; threads < maxThreads; threads *= 2)
+    threadCounts.push_back(threads);
+  threadCounts.push_back(maxThreads);  // Always finish with the full thread count
+
+  for (int readPercent : readMixes) {
+    for (int threads : threadCounts) {
+      // Lock-free skip list, prefilled to half the key range
+      ConcurrentSortedList<int> skip;
+      for (int k = 0; k < kKeyRange; k += 2)
+        skip.insert(k);
+      double lockFree = runMix(threads, millis, readPercent,
+        [&](int k) { return skip.contains(k); },
+        [&](int k) { return skip.insert(k); },
+        [&](int k) { return skip.remove(k); });
+
+      // Baseline: one big mutex around an ordered set, prefilled the same way
+      std::set<int> set;
+      std::mutex setMutex;
+      for (int k = 0; k < kKeyRange; k += 2)
+        set.insert(k);
+      double locked = runMix(threads, millis, readPercent,
+        [&](int k) { std::lock_guard<std::mutex> lock(setMutex); return set.count(k) != 0; },
+        [&](int k) { std::lock_guard<std::mutex> lock(setMutex); return set.insert(k).second; },
+        [&](int k) { std::lock_guard<std::mutex> lock(setMutex); return set.erase(k) != 0; });
+
+      std::cout << std::setw(8) << threads << std::setw(8) << readPercent
+        << std::fixed << std::setprecision(2)
+        << std::setw(14) << lockFree / 1e6 << std::setw(14) << locked / 1e6
+        << std::setw(9) << lockFree / locked << "x" << std::endl;
+    }
+  }
+  return 0;
+}
@@ -4,12 +4,24 @@
 // Driver program to test the SortedList template class implementation.
 // Tests core functionality, operator overloads, exception handling,
 // and the Rule of Five (special member functions for proper resource management).
+//
+// Compilation: g++ -std=c++17 -Wall -g -pthread driver.cpp SortedList.cpp ConcurrentSortedList.cpp -o driver
+// Execution:   ./driver
 
 #include "SortedList.h"
+#include "ConcurrentSortedList.h"
 #include <iostream>
 #include <string>
 #include <stdexcept>
 #include <cassert>
+#include <algorithm>
+#include <memory_resource>
+#include <random>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <sstream>
 
 using namespace std;
 
@@ -175,6 +187,366 @@ void testRuleOfFive() {
   // Tested implicitly as all local objects go out of scope and are destroyed
 }
 
+// ============================================================================
+// TEST FUNCTION 4: MOVE INSERT, EMPLACE AND ARENA ALLOCATION
+// ============================================================================
+// Tests insertion by move and in-place construction, and lists whose nodes
+// come from a monotonic arena instead of the global heap
+void testMoveAndArena() {
+  cout << "--- Testing Move Insert, Emplace and Arena ---" << endl;
+
+  // Insert by move: the source string is left moved-from
+  SortedList<string> words;
+  string pear = "pear";
+  words.insert(std::move(pear));
+  words.emplace(5, 'b');                  // Constructs "bbbbb" in place
+  words.emplace("apple");
+  assert(words.size() == 3);
+  assert(words[0] == "apple" && words[1] == "bbbbb" && words[2] == "pear");
+  cout << "Moved/Emplaced List: " << words << endl;
+
+  // Arena-backed linked list: nodes come from a stack buffer
+  char buffer[4096];
+  std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer));
+  SortedList<int, LinkedLayout> pooled(&arena);
+  for (int i = 10; i > 0; --i)
+    pooled.insert(i);
+  assert(pooled.size() == 10 && pooled[0] == 1 && pooled[9] == 10);
+  assert(pooled.memoryResource() == &arena);
+  cout << "Arena List: " << pooled << endl;
+
+  // Copying out of the arena uses the default resource
+  SortedList<int, LinkedLayout> heapCopy = pooled;
+  assert(heapCopy == pooled);
+  assert(heapCopy.memoryResource() == std::pmr::get_default_resource());
+
+  // Moving between lists with different resources moves element by element
+  SortedList<int, LinkedLayout> other;
+  other = std::move(pooled);
+  assert(other.size() == 10 && pooled.empty());
+  for (int i = 0; i < other.size(); ++i)
+    assert(other[i] == i + 1);
+  assert(other.memoryResource() == std::pmr::get_default_resource());
+
+  // If the target's resource runs out part way, both lists are left as they were
+  char small[512];
+  std::pmr::monotonic_buffer_resource limited(small, sizeof(small), std::pmr::null_memory_resource());
+  SortedList<string> bounded(&limited);
+  bounded.insert("kept");
+  SortedList<string> source;
+  for (int i = 0; i < 20; ++i)
+    source.insert(string(20, static_cast<char>('a' + i)));
+  bool threw = false;
+  try {
+    bounded = std::move(source);
+  }
+  catch (const std::bad_alloc&) {
+    threw = true;
+  }
+  assert(threw);
+  assert(bounded.size() == 1 && bounded[0] == "kept");
+  assert(source.size() == 20 && source[0] == string(20, 'a') && source[19] == string(20, 't'));
+
+  // Clear on an arena-backed list releases all nodes in one step
+  assert(pooled.memoryResource() == &arena);
+  pooled.insert(42);
+  pooled.insert(7);
+  pooled.clear();
+  assert(pooled.empty());
+  pooled.insert(3);
+  assert(pooled.size() == 1 && pooled[0] == 3);
+  cout << "Move Insert, Emplace and Arena Test Passed." << endl << endl;
+}
+
+// ============================================================================
+// TEST FUNCTION 5: CONTIGUOUS LAYOUT
+// ============================================================================
+// SortedList<int> selects the contiguous array layout. Runs the same random
+// inserts and removes against the linked layout and checks they agree.
+void testContiguousLayout() {
+  cout << "--- Testing Contiguous Layout ---" << endl;
+
+  static_assert(std::is_same<SortedList<int>, SortedList<int, ContiguousLayout>>::value,
+    "int keys should default to the contiguous layout");
+  static_assert(std::is_same<SortedList<string>, SortedList<string, LinkedLayout>>::value,
+    "string keys should default to the linked layout");
+
+  SortedList<int> flat;
+  SortedList<int, LinkedLayout> linked;
+  std::mt19937 gen(7);
+  std::uniform_int_distribution<int> value(-500, 500);
+  for (int i = 0; i < 2000; ++i) {
+    int v = value(gen);
+    if (i % 3 == 2)
+      assert(flat.remove(v) == linked.remove(v));
+    else
+      assert(flat.insert(v) && linked.insert(v));
+  }
+  assert(flat.size() == linked.size());
+  for (int i = 0; i < flat.size(); ++i)
+    assert(flat[i] == linked[i]);
+
+  // Self-referencing insert: the argument aliases an element that shifts
+  flat.insert(flat[0]);
+  assert(flat[0] == flat[1]);
+
+  // Moving into a list whose resource is too small throws instead of terminating
+  char small[256];
+  std::pmr::monotonic_buffer_resource limited(small, sizeof(small), std::pmr::null_memory_resource());
+  SortedList<int> bounded(&limited);
+  bounded.insert(1);
+  int flatSize = flat.size();
+  bool threw = false;
+  try {
+    bounded = std::move(flat);
+  }
+  catch (const std::bad_alloc&) {
+    threw = true;
+  }
+  assert(threw && bounded.size() == 1 && bounded[0] == 1 && flat.size() == flatSize);
+  cout << "Contiguous size after random ops: " << flat.size() << endl;
+  cout << "Contiguous Layout Test Passed." << endl << endl;
+}
+
+// ============================================================================
+// TEST FUNCTION 6: CONCURRENT SORTED LIST
+// ============================================================================
+// Several threads insert disjoint ranges while others remove and search.
+// After joining, exactly the values that were never removed must remain.
+void testConcurrentList() {
+  cout << "--- Testing Concurrent Sorted List ---" << endl;
+
+  ConcurrentSortedList<int> clist;
+  assert(clist.insert(5) == true);
+  assert(clist.insert(5) == false);       // Set semantics: no duplicates
+  assert(clist.contains(5) == true);
+  assert(clist.remove(5) == true);
+  assert(clist.remove(5) == false);
+  assert(clist.empty() == true);
+
+  const int threads = 4;
+  const int perThread = 5000;
+  vector<thread> workers;
+  for (int t = 0; t < threads; ++t) {
+    workers.emplace_back([&clist, t]() {
+      // Thread t owns the values congruent to t modulo threads
+      for (int i = 0; i < perThread; ++i)
+        clist.insert(i * threads + t);
+      // Remove every value of ours divisible by 3, searching as we go
+      for (int i = 0; i < perThread; ++i) {
+        int v = i * threads + t;
+        assert(clist.contains(v) == true);
+        if (v % 3 == 0)
+          assert(clist.remove(v) == true);
+      }
+      });
+  }
+  for (thread& w : workers)
+    w.join();
+
+  int expected = 0;
+  for (int v = 0; v < threads * perThread; ++v) {
+    assert(clist.contains(v) == (v % 3 != 0));
+    expected += (v % 3 != 0) ? 1 : 0;
+  }
+  assert(clist.size() == expected);
+  cout << "Concurrent list size after " << threads << " threads: " << clist.size() << endl;
+  cout << "Concurrent Sorted List Test Passed." << endl << endl;
+}
+
+// ============================================================================
+// TEST FUNCTION 7: STRING PREFIX COMPARISONS
+// ============================================================================
+// String nodes compare through a cached 8-byte prefix and length. Strings that
+// share long prefixes, differ only past byte 8, contain embedded '\0' or high
+// bytes must still come out in std::string order.
+void testStringPrefixOrder() {
+  cout << "--- Testing String Prefix Comparisons ---" << endl;
+
+  vector<string> words = { "", "a", string("a\0", 2), "ab", "abcdefgh",
+    "abcdefghi", "abcdefgh\xff", "abcdefgha", "abcdefghij", "zzzzzzzzzz",
+    "\xe9t\xe9", "abcdefgg", "abcdefghh" };
+  std::mt19937 gen(11);
+  std::uniform_int_distribution<int> len(0, 14);
+  std::uniform_int_distribution<int> ch(0, 3);
+  for (int i = 0; i < 300; ++i) {
+    string w(len(gen), 'a');
+    for (char& c : w)
+      c = static_cast<char>("ab\0\x90"[ch(gen)]);
+    words.push_back(w);
+  }
+
+  SortedList<string> list;
+  for (const string& w : words)
+    list.insert(w);
+  vector<string> expected = words;
+  std::sort(expected.begin(), expected.end());
+  assert(list.size() == static_cast<int>(expected.size()));
+  for (int i = 0; i < list.size(); ++i)
+    assert(list[i] == expected[i]);
+
+  // Removal must match on the full string, not just the prefix
+  assert(list.remove("abcdefghz") == false);
+  assert(list.remove("abcdefghij") == true);
+  assert(list.remove(string("a\0", 2)) == true);
+
+  // The cached prefix cannot go stale: string elements are read-only through
+  // operator[], while uncached element types can still be edited in place
+  static_assert(std::is_same<decltype(list[0]), const string&>::value,
+    "string elements must not be editable in place");
+  static_assert(std::is_same<decltype(std::declval<SortedList<int, LinkedLayout>&>()[0]), int&>::value,
+    "int elements stay editable");
+  SortedList<int, LinkedLayout> numbers;
+  numbers.insert(10);
+  numbers.insert(20);
+  numbers[1] = 30;                        // Order-preserving edit
+  assert(numbers.remove(30) && !numbers.remove(20));
+  cout << "String Prefix Comparisons Test Passed." << endl << endl;
+}
+
+// ============================================================================
+// TEST FUNCTION 8: BINARY SERIALIZATION AND TEXT OUTPUT
+// ============================================================================
+// Round-trips both layouts through the binary format, checks that truncated or
+// corrupted input is rejected without touching the list, and that the
+// buffered text output matches the original element-by-element format.
+void testSerialization() {
+  cout << "--- Testing Binary Serialization ---" << endl;
+
+  SortedList<int> ints;
+  for (int v : { 7, -3, 2000000000, -2000000000, 7, 0, 129 })
+    ints.insert(v);
+  stringstream intStream;
+  assert(ints.saveBinary(intStream) == true);
+  SortedList<int> intsLoaded;
+  assert(intsLoaded.loadBinary(intStream) == true);
+  assert(intsLoaded == ints);
+
+  SortedList<string> words;
+  for (const char* w : { "pear", "apple", "", "a much longer string than eight bytes" })
+    words.insert(w);
+  stringstream wordStream;
+  assert(words.saveBinary(wordStream) == true);
+  wordStream << "trailing data";        // The reader must stop at the list's end
+  SortedList<string> wordsLoaded;
+  assert(wordsLoaded.loadBinary(wordStream) == true);
+  assert(wordsLoaded == words);
+  string rest;
+  wordStream >> rest;
+  assert(rest == "trailing");
+
+  // Truncated and mismatched input leave the target unchanged
+  string bytes = intStream.str();
+  stringstream truncated(bytes.substr(0, bytes.size() - 1));
+  assert(intsLoaded.loadBinary(truncated) == false);
+  assert(intsLoaded == ints);
+  stringstream wrongKind(wordStream.str());
+  assert(intsLoaded.loadBinary(wrongKind) == false);
+  assert(intsLoaded.size() == ints.size());
+
+  // A header claiming a huge payload fails on the missing bytes; it neither
+  // throws nor allocates the claimed size
+  string header = bytes.substr(0, 6);
+  header.push_back(static_cast<char>(1));                 // One element
+  for (int i = 0; i < 9; ++i)
+    header.push_back(static_cast<char>(0xFF));            // About 2^63 bytes
+  header.push_back(static_cast<char>(0x01));
+  stringstream oversized(header + "abc");
+  assert(intsLoaded.loadBinary(oversized) == false);
+  assert(intsLoaded == ints);
+  string gigabyte = bytes.substr(0, 6);
+  gigabyte.push_back(static_cast<char>(1));
+  gigabyte += string("\x80\x80\x80\x80\x04", 5);         // 2^30 bytes
+  stringstream truncatedHeader(gigabyte + "abc");
+  assert(intsLoaded.loadBinary(truncatedHeader) == false);
+  stringstream headerOnly(bytes.substr(0, 7));
+  assert(intsLoaded.loadBinary(headerOnly) == false);
+  assert(intsLoaded == ints);
+
+  // Buffered text output keeps the ", " format; hex formatting still applies
+  stringstream text;
+  text << ints;
+  assert(text.str() == "-2000000000, -3, 0, 7, 7, 129, 2000000000");
+  stringstream hexText;
+  SortedList<int> small;
+  small.insert(255);
+  small.insert(16);
+  hexText << std::hex << small;
+  assert(hexText.str() == "10, ff");
+  cout << "Serialized int list: " << bytes.size() << " bytes for " << ints.size() << " elements" << endl;
+  cout << "Binary Serialization Test Passed." << endl << endl;
+}
+
+// ============================================================================
+// TEST FUNCTION 9: UNROLLED LAYOUT
+// ============================================================================
+// Runs the same random insert/remove sequence against the unrolled and the
+// contiguous layouts, so block splits, spills and merges are checked against
+// a known-good order, then checks appends, merge and a save/load round trip.
+void testUnrolledLayout() {
+  cout << "--- Testing Unrolled Layout ---" << endl;
+
+  SortedList<int, UnrolledLayout<>> blocks;
+  SortedList<int> flat;
+  std::mt19937 gen(11);
+  std::uniform_int_distribution<int> value(-2000, 2000);
+  for (int i = 0; i < 6000; ++i) {
+    int v = value(gen);
+    if (i % 3 == 2)
+      assert(blocks.remove(v) == flat.remove(v));
+    else
+      assert(blocks.insert(v) && flat.insert(v));
+  }
+  assert(blocks.size() == flat.size());
+  for (int i = 0; i < flat.size(); ++i)
+    assert(blocks[i] == flat[i]);
+
+  // Drain most of the list so under-full blocks merge back together
+  for (int i = 0; i < 3000; ++i) {
+    int v = value(gen);
+    assert(blocks.remove(v) == flat.remove(v));
+  }
+  for (int i = 0; i < flat.size(); ++i)
+    assert(blocks[i] == flat[i]);
+
+  // Ascending inserts append whole blocks; merge and copies keep the order
+  SortedList<int, UnrolledLayout<>> ascending;
+  for (int i = 0; i < 500; ++i)
+    ascending.insert(i);
+  SortedList<int, UnrolledLayout<>> merged = ascending + blocks;
+  assert(merged.size() == ascending.size() + blocks.size());
+  for (int i = 1; i < merged.size(); ++i)
+    assert(merged[i - 1] <= merged[i]);
+  SortedList<int, UnrolledLayout<>> copy(merged);
+  assert(copy == merged);
+
+  // Self-referencing insert: the argument aliases an element that shifts
+  copy.insert(copy[0]);
+  assert(copy[0] == copy[1]);
+
+  stringstream bytes;
+  assert(merged.saveBinary(bytes) == true);
+  SortedList<int, UnrolledLayout<>> loaded;
+  assert(loaded.loadBinary(bytes) == true);
+  assert(loaded == merged);
+
+  // Moving into a list whose resource runs out part way leaves both intact
+  char small[1024];
+  std::pmr::monotonic_buffer_resource limited(small, sizeof(small), std::pmr::null_memory_resource());
+  SortedList<int, UnrolledLayout<>> bounded(&limited);
+  bounded.insert(1);
+  bool threw = false;
+  try {
+    bounded = std::move(merged);
+  }
+  catch (const std::bad_alloc&) {
+    threw = true;
+  }
+  assert(threw && bounded.size() == 1 && bounded[0] == 1 && merged == loaded);
+  cout << "Unrolled size after random ops: " << blocks.size() << endl;
+  cout << "Unrolled Layout Test Passed." << endl << endl;
+}
+
 // ============================================================================
 // MAIN FUNCTION
 // ============================================================================
@@ -184,6 +556,12 @@ int main() {
   testCoreFunctionality();                // Test basic operations
   testOperatorsAndExceptions();           // Test operators and error handling
   testRuleOfFive();                       // Test memory management
+  testMoveAndArena();                     // Test move insert and arena allocation
+  testContiguousLayout();                 // Test contiguous int layout
+  testConcurrentList();                   // Test lock-free concurrent list
+  testStringPrefixOrder();                // Test cached string comparisons
+  testSerialization();                    // Test binary save/load and text output
+  testUnrolledLayout();                   // Test unrolled block layout
 
   cout << "All tests completed successfully!" << endl;
 
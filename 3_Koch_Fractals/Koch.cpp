@@ -3,14 +3,50 @@
 // 
 // Description:
 // Implementation of the Koch class and its nested TurtleHelper class.
-// This file contains the logic for the fractal generation and the Postscript output.
+// This file contains the logic for the fractal generation; KochOutput.cpp formats the output.
 //
 
 #include "Koch.h"
 #include <iostream>
 #include <cmath>
-#include <iomanip>
 #include <stdexcept>
+#include <algorithm>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <string>
+
+// --- Implementation of KochSegmentIterator ---
+
+const int KochSegmentIterator::DIGIT_TURN[4] = { 0, 1, HEADINGS - 1, 0 };
+
+// Constructor: every digit starts at 0, so every level keeps heading 0.
+KochSegmentIterator::KochSegmentIterator(int levels)
+  : depth(levels), digits(levels, 0), headings(levels + 1, 0), position(0), finished(false) {
+}
+
+// Advances like a base-4 odometer: the deepest digit below 3 is incremented,
+// the digits under it reset to 0, and only the headings below the changed
+// digit are recomputed.
+void KochSegmentIterator::next() {
+  int d = depth - 1;
+  while (d >= 0 && digits[d] == 3) {
+    --d;
+  }
+  if (d < 0) {
+    finished = true;
+    return;
+  }
+  ++digits[d];
+  headings[d + 1] = static_cast<unsigned char>((headings[d] + DIGIT_TURN[digits[d]]) % HEADINGS);
+  for (int e = d + 1; e < depth; ++e) {
+    digits[e] = 0;
+    headings[e + 1] = headings[e];
+  }
+  ++position;
+}
 
 // --- Implementation of TurtleHelper (Nested Class) ---
 
@@ -21,16 +57,10 @@ double Koch::TurtleHelper::degToRad(double degrees) const {
 }
 
 // Constructor
-Koch::TurtleHelper::TurtleHelper(double x, double y, double angle) : currentX(x), currentY(y), currentAngle(angle) {
-  // Set output precision for floating-point coordinates to ensure Postscript readability
-  std::cout << std::fixed << std::setprecision(3);
-
-  // Output Postscript Header and Bounding Box
-  std::cout << "%!PS-Adobe-2.0" << std::endl;
-  std::cout << "%%BoundingBox: 0 0 600 600" << std::endl;  // Define canvas size
-
-  // Output initial moveto command to set the starting point of the path
-  std::cout << currentX << " " << currentY << " moveto" << std::endl;
+Koch::TurtleHelper::TurtleHelper(double x, double y, double angle, PathSink& output)
+  : currentX(x), currentY(y), currentAngle(angle), sink(output) {
+  // Output the initial moveto (and, for a new document, the header)
+  sink.beginPath(currentX, currentY);
 }
 
 // Changes the currentAngle by the specified number of degrees.
@@ -59,26 +89,28 @@ void Koch::TurtleHelper::drawLine(double length) {
   currentX += dx;
   currentY += dy;
 
-  // Output rlineto command (relative line to) to Postscript output
-  std::cout << dx << " " << dy << " rlineto" << std::endl;
+  // Output rlineto command (relative line to)
+  sink.lines(&dx, &dy, 1);
+}
+
+// Moves the current position without producing output.
+void Koch::TurtleHelper::moveBy(double dx, double dy) {
+  currentX += dx;
+  currentY += dy;
 }
 
 // Outputs the 'stroke' Postscript command to render the path.
 void Koch::TurtleHelper::outputStroke() {
   // Renders the path defined by moveto/rlineto commands
-  std::cout << "stroke" << std::endl;
-}
-
-// Outputs the 'showpage' Postscript command to display the page.
-void Koch::TurtleHelper::outputShowpage() {
-  // Finalizes the Postscript output and displays the page
-  std::cout << "showpage" << std::endl;
+  sink.endPath();
 }
 
 // --- Implementation of Koch Class ---
 
 // Constructor
-Koch::Koch() : turtle(nullptr) {
+Koch::Koch() : turtle(nullptr), engine(RECURSIVE), output(nullptr), threads(1), detail(0.0),
+  clipped(false), viewMinX(0.0), viewMinY(0.0), viewMaxX(0.0), viewMaxY(0.0), blockLevel(0),
+  patternLevel(-1) {
  // Initialize turtle pointer to nullptr. The actual TurtleHelper object
  // is dynamically created and managed within generateCurve
 }
@@ -88,6 +120,58 @@ Koch::~Koch() {
   delete turtle;
 }
 
+// Selects the generation engine used by generateCurve.
+void Koch::setEngine(Engine e) {
+  engine = e;
+}
+
+// Sets the number of worker threads for the table engine (at least 1).
+void Koch::setThreads(int count) {
+  threads = std::max(count, 1);
+}
+
+// Sets the level-of-detail limit in page units (0 disables it).
+void Koch::setDetail(double minLength) {
+  detail = std::max(minLength, 0.0);
+}
+
+// Sets the viewport used by later curves.
+void Koch::setViewport(double minX, double minY, double maxX, double maxY) {
+  if (!(minX <= maxX && minY <= maxY)) {
+    throw std::invalid_argument("viewport must have min <= max on both axes");
+  }
+  clipped = true;
+  viewMinX = minX;
+  viewMinY = minY;
+  viewMaxX = maxX;
+  viewMaxY = maxY;
+}
+
+// Generates whole curves again.
+void Koch::clearViewport() {
+  clipped = false;
+}
+
+// Level-of-detail limit.
+// A depth-d sub-curve lies inside the triangle over its base of length
+// length / 3^d with 30-degree base angles, so once that base is no longer than
+// 'detail' the whole sub-curve fits in about one pixel and its chord draws the
+// same pixels. Every sub-curve at a given depth has the same size, so the test
+// stops the recursion at the same depth everywhere, which is a cap on the level.
+int Koch::detailLevel(int level, double length) const {
+  int depth = 0;
+  while (depth < level && length > detail) {
+    length /= 3.0;
+    ++depth;
+  }
+  return detail > 0.0 ? depth : level;
+}
+
+// Selects the sink that receives generated curves.
+void Koch::setOutput(PathSink* sink) {
+  output = sink;
+}
+
 // Recursive Helper Function.
 // Implements the core Koch curve logic.
 void Koch::drawKoch(int level, double length) {
@@ -117,8 +201,453 @@ void Koch::drawKoch(int level, double length) {
   }
 }
 
-// Main public method to generate the curve.
-void Koch::generateCurve(int level, double x1, double y1, double x2, double y2) {
+// Builds the per-level displacement tables.
+// Lengths are divided by 3 level by level exactly as the recursion does, and
+// each heading's angle is normalized to [0, 360) the same way turn() does, so
+// both engines print the same coordinates. (The recursion accumulates its angle
+// turn by turn, so for enormous lengths, where one rounding step of the angle
+// shows at three decimals, the last printed digit can differ.)
+void Koch::buildDirectionTable(int level, double angleDeg, double length) {
+  const int rowWidth = 2 * HEADINGS;
+  tableDx.assign((level + 1) * rowWidth, 0.0);
+  tableDy.assign((level + 1) * rowWidth, 0.0);
+
+  // Unit direction for each heading; the only trigonometry in the engine
+  double unitX[HEADINGS];
+  double unitY[HEADINGS];
+  for (int h = 0; h < HEADINGS; ++h) {
+    double angle = std::fmod(angleDeg + 60.0 * h, 360.0);
+    if (angle < 0.0) {
+      angle += 360.0;
+    }
+    double angleRad = angle * M_PI / 180.0;
+    unitX[h] = std::cos(angleRad);
+    unitY[h] = std::sin(angleRad);
+  }
+
+  // Row 'depth' is scaled by the length of a depth-'depth' sub-curve
+  double depthLength = length;
+  for (int depth = level; depth >= 0; --depth) {
+    for (int h = 0; h < rowWidth; ++h) {
+      tableDx[depth * rowWidth + h] = depthLength * unitX[h % HEADINGS];
+      tableDy[depth * rowWidth + h] = depthLength * unitY[h % HEADINGS];
+    }
+    depthLength /= 3.0;
+  }
+}
+
+// Builds the heading pattern of a block: the heading of each segment relative
+// to the heading of its block. It is the same for every curve, so it is only
+// rebuilt when the block level changes.
+void Koch::buildBlockPattern(int depth) {
+  const int* DIGIT_TURN = KochSegmentIterator::DIGIT_TURN;
+
+  blockLevel = std::min(depth, static_cast<int>(BLOCK_LEVEL));
+  const std::size_t blockSize = std::size_t(1) << (2 * blockLevel);
+  if (patternLevel != blockLevel) {
+    blockPattern.assign(blockSize, 0);
+    for (std::size_t j = 1; j < blockSize; ++j) {
+      blockPattern[j] = (blockPattern[j >> 2] + DIGIT_TURN[j & 3]) % HEADINGS;
+    }
+    patternLevel = blockLevel;
+  }
+}
+
+// Builds the block templates for sub-curves of the given depth.
+// Segment i of a curve is reached by following the base-4 digits of i through
+// the recursion, and its heading is the sum of the turns those digits select.
+// Every block of 4^blockLevel segments has the same heading pattern, offset by
+// the block's own heading, so the displacements of a block are built once per
+// heading and then reused. The pattern is the curve's shape independent of its
+// endpoints: the rotation and scale of a curve live in its direction table.
+void Koch::buildBlockTemplates(int depth) {
+  buildBlockPattern(depth);
+  const std::size_t blockSize = std::size_t(1) << (2 * blockLevel);
+
+  // One block of displacements per heading. heading + pattern[j] < 2 * HEADINGS,
+  // so the lookup is a plain gather with no modulo, branch or trigonometry.
+  blocksDx.assign(HEADINGS * blockSize, 0.0);
+  blocksDy.assign(HEADINGS * blockSize, 0.0);
+  for (int heading = 0; heading < HEADINGS; ++heading) {
+    fillBlock(&tableDx[heading], &tableDy[heading], blockPattern.data(), blockSize,
+      &blocksDx[heading * blockSize], &blocksDy[heading * blockSize]);
+  }
+}
+
+// Emits a depth-'depth' sub-curve entered with the given heading, one block
+// template per step of a KochSegmentIterator over the levels above the blocks.
+// Memory does not grow with depth. Only reads shared state, so several threads
+// can emit different sub-curves at once.
+void Koch::emitSubcurve(int depth, int heading, PathSink& sink) const {
+  const std::size_t blockSize = std::size_t(1) << (2 * blockLevel);
+  for (KochSegmentIterator blocks(depth - blockLevel); !blocks.done(); blocks.next()) {
+    int blockHeading = (heading + blocks.heading()) % HEADINGS;
+    sink.lines(&blocksDx[blockHeading * blockSize], &blocksDy[blockHeading * blockSize], blockSize);
+  }
+}
+
+// Iterative table-driven generation of the whole curve.
+// With a viewport only the visible part is generated. Otherwise it runs on
+// the worker pool when more than one thread is configured and the sink can be
+// split, or streams the curve on this thread.
+void Koch::drawKochTable(int level, PathSink& sink, double x, double y) {
+  if (clipped) {
+    bool connected = true;  // The path starts at (x, y)
+    buildBlockTemplates(level);
+    clipSubcurve(level, 0, x, y, sink, connected);
+  }
+  else if (threads > 1 && level > 0 && sink.canFork()) {
+    drawKochParallel(level, sink, x, y);
+  }
+  else {
+    buildBlockTemplates(level);
+    emitSubcurve(level, 0, sink);
+  }
+  // The whole curve moves the turtle by its chord in the base heading
+  turtle->moveBy(tableDx[level * 2 * HEADINGS], tableDy[level * 2 * HEADINGS]);
+}
+
+// Viewport test for one sub-curve.
+// A Koch curve never leaves the triangle over its chord with 30-degree base
+// angles; the apex is sqrt(3)/6 of the chord to the left of its midpoint (the
+// bump turns left). The test uses the triangle's bounding box, widened by a
+// little for rounding in the accumulated start points, so it errs towards
+// PARTIAL and never drops a visible piece.
+Koch::Coverage Koch::viewportCoverage(double x, double y, double cx, double cy) const {
+  const double APEX = std::sqrt(3.0) / 6.0;
+  const double apexX = x + 0.5 * cx - APEX * cy;
+  const double apexY = y + 0.5 * cy + APEX * cx;
+  const double minX = std::min(std::min(x, x + cx), apexX);
+  const double maxX = std::max(std::max(x, x + cx), apexX);
+  const double minY = std::min(std::min(y, y + cy), apexY);
+  const double maxY = std::max(std::max(y, y + cy), apexY);
+  const double slack = 1e-9 * (std::fabs(x) + std::fabs(y) + std::fabs(cx) + std::fabs(cy));
+  if (maxX < viewMinX - slack || minX > viewMaxX + slack ||
+    maxY < viewMinY - slack || minY > viewMaxY + slack) {
+    return OUTSIDE;
+  }
+  if (minX >= viewMinX && maxX <= viewMaxX && minY >= viewMinY && maxY <= viewMaxY) {
+    return INSIDE;
+  }
+  return PARTIAL;
+}
+
+// Viewport-clipped generation of a sub-curve.
+// Sub-curves missing the viewport are skipped and ones wholly inside it are
+// emitted from the block templates untested, so only sub-curves crossing the
+// viewport's edge are subdivided; at depth 0 their segments are clipped.
+// A skipped or clipped stretch breaks the path, and the next visible segment
+// starts a new subpath. The recursion is only 'depth' calls deep.
+void Koch::clipSubcurve(int depth, int heading, double x, double y, PathSink& sink, bool& connected) const {
+  const int row = depth * 2 * HEADINGS;
+  const Coverage coverage = viewportCoverage(x, y, tableDx[row + heading], tableDy[row + heading]);
+  if (coverage == OUTSIDE) {
+    connected = false;
+    return;
+  }
+  if (coverage == INSIDE) {
+    if (!connected) {
+      sink.moveTo(x, y);
+      connected = true;
+    }
+    if (depth >= blockLevel) {
+      emitSubcurve(depth, heading, sink);
+    }
+    else {
+      // A shallower sub-curve is the start of a block of the same heading
+      const std::size_t blockSize = std::size_t(1) << (2 * blockLevel);
+      sink.lines(&blocksDx[heading * blockSize], &blocksDy[heading * blockSize], std::size_t(1) << (2 * depth));
+    }
+    return;
+  }
+  if (depth == 0) {
+    clipSegment(x, y, tableDx[heading], tableDy[heading], sink, connected);
+    return;
+  }
+  const int below = row - 2 * HEADINGS;
+  for (int digit = 0; digit < 4; ++digit) {
+    const int h = (heading + KochSegmentIterator::DIGIT_TURN[digit]) % HEADINGS;
+    clipSubcurve(depth - 1, h, x, y, sink, connected);
+    x += tableDx[below + h];
+    y += tableDy[below + h];
+  }
+}
+
+// Liang-Barsky clipping of the segment from (x, y) by (dx, dy): the part
+// inside the viewport is the parameter range [enter, leave] of the segment.
+// A segment that is not cut keeps its exact table displacement.
+void Koch::clipSegment(double x, double y, double dx, double dy, PathSink& sink, bool& connected) const {
+  double enter = 0.0;
+  double leave = 1.0;
+  const double step[4] = { -dx, dx, -dy, dy };
+  const double room[4] = { x - viewMinX, viewMaxX - x, y - viewMinY, viewMaxY - y };
+  for (int side = 0; side < 4; ++side) {
+    if (step[side] == 0.0) {
+      if (room[side] < 0.0) {
+        connected = false;
+        return;
+      }
+      continue;
+    }
+    const double t = room[side] / step[side];
+    if (step[side] < 0.0) {
+      enter = std::max(enter, t);
+    }
+    else {
+      leave = std::min(leave, t);
+    }
+  }
+  if (enter > leave) {
+    connected = false;
+    return;
+  }
+  if (!connected || enter > 0.0) {
+    sink.moveTo(x + enter * dx, y + enter * dy);
+  }
+  double partX = (leave - enter) * dx;
+  double partY = (leave - enter) * dy;
+  sink.lines(&partX, &partY, 1);
+  connected = leave == 1.0;
+}
+
+// Parallel table-driven generation.
+// The recursion tree is cut at depth 'split', giving 4^split pieces. Piece i
+// starts at the absolute point reached by the chords of the pieces before it,
+// in the heading its base-4 digits select, so workers need no turtle state.
+// Workers take pieces in order, render each into its own forked sink, and this
+// thread joins the finished pieces back into the sink in order. Workers stay
+// at most 'window' pieces ahead of the output, which bounds memory.
+void Koch::drawKochParallel(int level, PathSink& sink, double x, double y) {
+  // Enough pieces to keep every worker busy, never deeper than the curve
+  int split = 0;
+  while (split < level && (std::uint64_t(1) << (2 * split)) < std::uint64_t(4) * threads) {
+    ++split;
+  }
+  const int pieceDepth = level - split;
+  const std::size_t pieceCount = std::size_t(1) << (2 * split);
+  buildBlockTemplates(pieceDepth);
+
+  // Closed-form start of every piece
+  std::vector<int> pieceHeading(pieceCount);
+  std::vector<double> startX(pieceCount);
+  std::vector<double> startY(pieceCount);
+  const double* chordDx = &tableDx[pieceDepth * 2 * HEADINGS];
+  const double* chordDy = &tableDy[pieceDepth * 2 * HEADINGS];
+  double px = x;
+  double py = y;
+  for (KochSegmentIterator pieces(split); !pieces.done(); pieces.next()) {
+    std::size_t i = static_cast<std::size_t>(pieces.index());
+    pieceHeading[i] = pieces.heading();
+    startX[i] = px;
+    startY[i] = py;
+    px += chordDx[pieceHeading[i]];
+    py += chordDy[pieceHeading[i]];
+  }
+
+  // Shared state, guarded by 'lock'
+  std::vector<std::unique_ptr<PathSink>> finished(pieceCount);
+  std::mutex lock;
+  std::condition_variable pieceReady;    // Signals the joining thread
+  std::condition_variable windowOpen;    // Signals waiting workers
+  std::size_t nextPiece = 0;             // Next piece a worker will take
+  std::size_t joined = 0;                // Pieces already joined into the sink
+  std::exception_ptr failure;            // First error, stops everyone
+  const std::size_t window = 2 * static_cast<std::size_t>(threads);
+
+  auto worker = [&]() {
+    for (;;) {
+      std::size_t i;
+      {
+        std::unique_lock<std::mutex> guard(lock);
+        windowOpen.wait(guard, [&]() {
+          return failure || nextPiece >= pieceCount || nextPiece < joined + window;
+          });
+        if (failure || nextPiece >= pieceCount) {
+          return;
+        }
+        i = nextPiece++;
+      }
+      try {
+        std::unique_ptr<PathSink> piece = sink.fork(startX[i], startY[i]);
+        emitSubcurve(pieceDepth, pieceHeading[i], *piece);
+        std::lock_guard<std::mutex> guard(lock);
+        finished[i] = std::move(piece);
+      }
+      catch (...) {
+        std::lock_guard<std::mutex> guard(lock);
+        if (!failure) {
+          failure = std::current_exception();
+        }
+        windowOpen.notify_all();
+      }
+      pieceReady.notify_one();
+    }
+  };
+
+  std::vector<std::thread> pool;
+  for (int t = 0; t < threads; ++t) {
+    pool.emplace_back(worker);
+  }
+
+  // Join pieces in path order as they complete
+  for (std::size_t i = 0; i < pieceCount; ++i) {
+    std::unique_ptr<PathSink> piece;
+    {
+      std::unique_lock<std::mutex> guard(lock);
+      pieceReady.wait(guard, [&]() { return failure || finished[i]; });
+      if (failure) {
+        break;
+      }
+      piece = std::move(finished[i]);
+    }
+    try {
+      sink.join(*piece);
+    }
+    catch (...) {
+      std::lock_guard<std::mutex> guard(lock);
+      failure = std::current_exception();
+    }
+    {
+      std::lock_guard<std::mutex> guard(lock);
+      joined = i + 1;
+      if (failure) {
+        break;
+      }
+    }
+    windowOpen.notify_all();
+  }
+
+  windowOpen.notify_all();
+  for (std::thread& t : pool) {
+    t.join();
+  }
+  if (failure) {
+    std::rethrow_exception(failure);
+  }
+}
+
+// --- Lattice engine ---
+
+namespace {
+
+// Lattice step for each heading. Lattice point (a, b) is a * u + b * v, where
+// u is one segment in the base direction and v is u turned left 60 degrees;
+// the other headings follow from v - u being u turned 120 degrees.
+const int LATTICE_STEP_A[6] = { 1, 0, -1, -1, 0, 1 };
+const int LATTICE_STEP_B[6] = { 0, 1, 1, 0, -1, -1 };
+
+} // namespace
+
+// Builds the lattice templates: a running sum of the lattice steps of each
+// block's segments, once per block heading.
+void Koch::buildLatticeTemplates(int depth) {
+  buildBlockPattern(depth);
+  const std::size_t blockSize = std::size_t(1) << (2 * blockLevel);
+  latticeA.assign(HEADINGS * blockSize, 0);
+  latticeB.assign(HEADINGS * blockSize, 0);
+  for (int heading = 0; heading < HEADINGS; ++heading) {
+    std::int32_t a = 0;
+    std::int32_t b = 0;
+    for (std::size_t j = 0; j < blockSize; ++j) {
+      const int h = (heading + blockPattern[j]) % HEADINGS;
+      a += LATTICE_STEP_A[h];
+      b += LATTICE_STEP_B[h];
+      latticeA[heading * blockSize + j] = a;
+      latticeB[heading * blockSize + j] = b;
+    }
+  }
+}
+
+// Lattice generation.
+// A level-n curve has segments 1 / 3^n of its base, and a depth-d sub-curve's
+// chord is 3^d lattice steps in its heading, so every vertex is an integer
+// lattice point. The block start is kept in 64-bit integers; each vertex is
+// converted to page units on its own (start + a * u + b * v), so no error is
+// carried from one segment to the next, and each emitted displacement is the
+// difference of two converted vertices. Neighbouring vertices are close, so
+// the subtraction is exact in practice and adding the displacement back to
+// the previous vertex gives the next one: a sink that sums displacements
+// stays on the lattice, and the curve ends exactly at x1 + 3^level * u.
+void Koch::drawKochLattice(int level, PathSink& sink, double x1, double y1, double x2, double y2) {
+  if (level > MAX_LATTICE_LEVEL) {
+    throw std::invalid_argument("lattice engine level is limited to " + std::to_string(MAX_LATTICE_LEVEL));
+  }
+  std::int64_t segmentsAcross = 1;   // 3^level
+  for (int i = 0; i < level; ++i) {
+    segmentsAcross *= 3;
+  }
+  const double HALF_SQRT3 = std::sqrt(3.0) / 2.0;
+  const double ux = (x2 - x1) / static_cast<double>(segmentsAcross);
+  const double uy = (y2 - y1) / static_cast<double>(segmentsAcross);
+  const double vx = 0.5 * ux - HALF_SQRT3 * uy;
+  const double vy = HALF_SQRT3 * ux + 0.5 * uy;
+
+  buildLatticeTemplates(level);
+  const std::size_t blockSize = std::size_t(1) << (2 * blockLevel);
+  std::int64_t blockChord = 1;       // 3^blockLevel
+  for (int i = 0; i < blockLevel; ++i) {
+    blockChord *= 3;
+  }
+
+  std::vector<double> pointX(blockSize + 1);
+  std::vector<double> pointY(blockSize + 1);
+  std::vector<double> stepX(blockSize);
+  std::vector<double> stepY(blockSize);
+  std::int64_t a = 0;                // Lattice coordinates of the block start
+  std::int64_t b = 0;
+  pointX[blockSize] = x1;
+  pointY[blockSize] = y1;
+  for (KochSegmentIterator blocks(level - blockLevel); !blocks.done(); blocks.next()) {
+    const int heading = blocks.heading();
+    const std::int32_t* offsetA = &latticeA[heading * blockSize];
+    const std::int32_t* offsetB = &latticeB[heading * blockSize];
+
+    // Vertices of this block, after the last vertex of the previous one
+    pointX[0] = pointX[blockSize];
+    pointY[0] = pointY[blockSize];
+    latticeBlock(offsetA, offsetB, blockSize, static_cast<double>(a), static_cast<double>(b),
+      x1, ux, vx, &pointX[1], stepX.data());
+    latticeBlock(offsetA, offsetB, blockSize, static_cast<double>(a), static_cast<double>(b),
+      y1, uy, vy, &pointY[1], stepY.data());
+    sink.lines(stepX.data(), stepY.data(), blockSize);
+
+    a += blockChord * LATTICE_STEP_A[heading];
+    b += blockChord * LATTICE_STEP_B[heading];
+  }
+}
+
+// Inner loop of the lattice engine, one axis at a time: converts the block's
+// vertices (start + offsets) to page units, then takes their differences.
+// point[-1] must hold the vertex before the block. Integers below 2^53 add
+// exactly as doubles, so the conversion is the same as from 64-bit integers.
+void Koch::latticeBlock(const std::int32_t* __restrict offsetA, const std::int32_t* __restrict offsetB,
+  std::size_t count, double startA, double startB, double origin, double u, double v,
+  double* __restrict point, double* __restrict step) {
+  for (std::size_t j = 0; j < count; ++j) {
+    point[j] = origin + ((startA + offsetA[j]) * u + (startB + offsetB[j]) * v);
+  }
+  const double* before = point - 1;
+  for (std::size_t j = 0; j < count; ++j) {
+    step[j] = point[j] - before[j];
+  }
+}
+
+// Gathers one block of displacements from a table row.
+// The pointers never overlap, which lets the compiler vectorize the gather.
+void Koch::fillBlock(const double* __restrict rowDx, const double* __restrict rowDy,
+  const int* __restrict pattern, std::size_t count,
+  double* __restrict outDx, double* __restrict outDy) {
+  for (std::size_t j = 0; j < count; ++j) {
+    outDx[j] = rowDx[pattern[j]];
+    outDy[j] = rowDy[pattern[j]];
+  }
+}
+
+// Draws one curve as a path: moveto, the segments and stroke.
+// For the table engine, rotating and scaling the curve's template to the
+// endpoints is folded into the six-entry direction table, so each segment is
+// a gather from that table; translating it is the path's start point.
+void Koch::drawCurve(int level, double x1, double y1, double x2, double y2, PathSink& sink) {
   // 1. Calculate initial angle (in degrees) of the level 0 segment using atan2
   double dx = x2 - x1;
   double dy = y2 - y1;
@@ -129,18 +658,31 @@ void Koch::generateCurve(int level, double x1, double y1, double x2, double y2)
   // 2. Calculate initial length (d) using Euclidean distance: d = sqrt((x2-x1)^2 + (y2-y1)^2)
   double initialLength = std::sqrt(dx * dx + dy * dy);
 
+  // Sub-pixel levels are not generated (see detailLevel)
+  level = detailLevel(level, initialLength);
+
   // 3. Initialize the TurtleHelper object.
-  // The constructor outputs the Postscript header and 'moveto' command.
+  // The constructor outputs the Postscript header (first path only) and 'moveto' command.
   // Clean up any existing turtle object before creating a new one.
   if (turtle) delete turtle;
-  turtle = new TurtleHelper(x1, y1, initialAngleDeg);
+  turtle = new TurtleHelper(x1, y1, initialAngleDeg, sink);
 
   try {
-    // 4. Start the recursion with the desired level and the total length of the base segment.
-    drawKoch(level, initialLength);
-    // 5. Output final Postscript commands to render the path.  
+    // 4. Start the recursion with the desired level and the total length of the base segment,
+    // or run the table engine over the same curve.
+    if (engine == DIRECTION_TABLE || clipped) {
+      buildDirectionTable(level, initialAngleDeg, initialLength);
+      drawKochTable(level, sink, x1, y1);
+    }
+    else if (engine == LATTICE) {
+      drawKochLattice(level, sink, x1, y1, x2, y2);
+      turtle->moveBy(dx, dy);
+    }
+    else {
+      drawKoch(level, initialLength);
+    }
+    // 5. Output 'stroke' to render the path.
     turtle->outputStroke();
-    turtle->outputShowpage();
   }
   catch (...) {
     // 6. Exception Safetey: If recursion fails, ensure the dynamically allocated memory is cleaned up.
@@ -153,4 +695,38 @@ void Koch::generateCurve(int level, double x1, double y1, double x2, double y2)
   // This ensures the memory is freed after the function completes.
   delete turtle;
   turtle = nullptr;
-}
\ No newline at end of file
+}
+
+// Main public method to generate the curve: a batch of one.
+void Koch::generateCurve(int level, double x1, double y1, double x2, double y2) {
+  std::vector<KochJob> job(1);
+  job[0].x1 = x1;
+  job[0].y1 = y1;
+  job[0].x2 = x2;
+  job[0].y2 = y2;
+  job[0].level = level;
+  generateBatch(job);
+}
+
+// Generates every job into one document.
+void Koch::generateBatch(const std::vector<KochJob>& jobs) {
+  // Pick the output sink. Without one, PostScript goes to standard output
+  // through a buffered writer on descriptor 1; anything already buffered in
+  // std::cout is flushed first so the two cannot interleave.
+  PathSink* sink = output;
+  std::unique_ptr<FileOutput> standardOutput;
+  std::unique_ptr<PostScriptWriter> standardWriter;
+  if (sink == nullptr) {
+    std::cout.flush();
+    standardOutput.reset(new FileOutput(1));
+    standardWriter.reset(new PostScriptWriter(*standardOutput));
+    sink = standardWriter.get();
+  }
+
+  for (const KochJob& job : jobs) {
+    drawCurve(job.level, job.x1, job.y1, job.x2, job.y2, *sink);
+  }
+
+  // Output 'showpage' and flush the document
+  sink->finish();
+}
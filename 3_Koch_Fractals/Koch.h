@@ -3,7 +3,27 @@
 // 
 // Description:
 // Defines the Koch class, which encapsulates the recursive algorithm for generating the Koch curve.
-// It includes a private nested class, TurtleHelper, to manage the drawing state and Postscript output.
+// It includes a private nested class, TurtleHelper, to manage the drawing state and hand the
+// path to an output sink (PostScript on standard output unless another sink is set).
+//
+// Three generation engines produce the same path:
+//   - RECURSIVE: the original turtle recursion, one cos/sin call per segment.
+//   - DIRECTION_TABLE: every Koch turn is a multiple of 60 degrees, so the heading is
+//     tracked as an integer 0-5 and each segment's (dx, dy) is looked up in a table
+//     computed once per curve. Segments are produced in blocks without recursion.
+//     Blocks are enumerated by a KochSegmentIterator (an explicit stack of base-4
+//     digits), so memory stays constant at any level and deep levels can be streamed.
+//     With several threads the curve is cut into sub-curves that workers render
+//     in parallel from their closed-form start points; output order is preserved.
+//   - LATTICE: every vertex of a level-n curve lies on the triangular lattice
+//     spanned by the first segment and its 60-degree turn, so vertices are kept
+//     as exact integer (Eisenstein) coordinates and converted to page units only
+//     when emitted. Positions never drift, and the output does not depend on
+//     the order of the arithmetic.
+//
+// With a viewport set, the table engine skips every sub-curve whose bounding
+// triangle misses the viewport and clips the segments on its edge, so a deep
+// zoom tile costs about as much as the segments it shows.
 //
 
 #ifndef KOCH_H
@@ -11,30 +31,82 @@
 
 #include <iostream>
 #include <cmath>
-#include <iomanip>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "KochOutput.h"
 
 // Define PI for angle calculations
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
 #endif
 
+// --- Class: KochSegmentIterator ---
+// Description: Visits the segments of a level-'depth' Koch curve in drawing order
+// without recursion. The recursion stack is replaced by one base-4 digit per
+// level (which of the four sub-segments is being drawn at that level) plus the
+// heading reached at that level, so memory is O(depth) and each step costs
+// amortized O(1). Headings are integers 0-5 in steps of 60 degrees.
+class KochSegmentIterator {
+private:
+  int depth;                            // Number of recursion levels.
+  std::vector<unsigned char> digits;    // digits[d]: sub-segment (0-3) chosen at level d.
+  std::vector<unsigned char> headings;  // headings[d]: heading on entry to level d.
+  std::uint64_t position;               // Index of the current segment.
+  bool finished;                        // True once every segment has been visited.
+
+public:
+  // Heading change selected by each digit: sub-segments 0 and 3 keep the
+  // parent heading, 1 turns left 60 degrees, 2 turns right 60 degrees.
+  static const int DIGIT_TURN[4];
+
+  // Number of distinct headings (multiples of 60 degrees)
+  static const int HEADINGS = 6;
+
+  // Constructor: Positions the iterator on the first segment.
+  explicit KochSegmentIterator(int levels);
+
+  // True once the last segment has been passed.
+  bool done() const { return finished; }
+
+  // Heading (0-5) of the current segment, relative to the curve's base angle.
+  int heading() const { return headings[depth]; }
+
+  // Index of the current segment, 0 .. 4^depth - 1.
+  std::uint64_t index() const { return position; }
+
+  // Advances to the next segment.
+  void next();
+};
+
+// --- Struct: KochJob ---
+// Description: One curve of a batch: the level 0 segment and the level.
+struct KochJob {
+  double x1;
+  double y1;
+  double x2;
+  double y2;
+  int level;
+};
+
 class Koch {
 private:
   // --- Private Nested Class: TurtleHelper ---
   // Description: Manages the virtual drawing pen's state (position and angle)
-  // and translates drawing actions into Postscript commands printed to standard output.
+  // and translates drawing actions into path commands for the output sink.
   class TurtleHelper {
   private:
     double currentX;      // Current X-coordinate of the turtle.
     double currentY;      // Current Y-coordinate of the turtle.
     double currentAngle;  // Current direction (angle in degrees).
+    PathSink& sink;       // Receives the drawn path.
 
     // Helper function to convert degrees to radians
     double degToRad(double degrees) const;
 
   public:
-    // Constructor: Initializes position and angle. Outputs Postscript header and 'moveto'.
-    TurtleHelper(double x, double y, double angle);
+    // Constructor: Initializes position and angle. Starts the path at (x, y).
+    TurtleHelper(double x, double y, double angle, PathSink& output);
 
     // Changes the currentAngle by the specified number of degrees.
     void turn(double degrees);
@@ -42,15 +114,62 @@ private:
     // Calculates displacement, updates position, and outputs 'rlineto'.
     void drawLine(double length);
 
-    // Outputs the 'stroke' Postscript command.
+    // Moves the current position without drawing or turning.
+    void moveBy(double dx, double dy);
+
+    // Ends the path ('stroke').
     void outputStroke();
+  };
 
-    // Outputs the 'showpage' Postscript command.
-    void outputShowpage();
+public:
+  // Curve generation strategies (see the file header)
+  enum Engine {
+    RECURSIVE,
+    DIRECTION_TABLE,
+    LATTICE
   };
 
+private:
+  // Number of distinct headings on a Koch curve (multiples of 60 degrees)
+  static const int HEADINGS = KochSegmentIterator::HEADINGS;
+
+  // Segments per block in the table engine: 4^BLOCK_LEVEL
+  static const int BLOCK_LEVEL = 5;
+
   // --- Koch Class Members ---
   TurtleHelper* turtle; // Pointer to the TurtleHelper object.
+  Engine engine;        // Strategy used by generateCurve.
+  PathSink* output;     // Destination for the curve; nullptr means PostScript on stdout.
+  int threads;          // Worker threads for the table engine.
+  double detail;        // Smallest sub-curve worth subdividing (page units); 0 = full detail.
+  bool clipped;         // True if a viewport is set.
+  double viewMinX;      // Viewport (page units), valid when clipped.
+  double viewMinY;
+  double viewMaxX;
+  double viewMaxY;
+
+  // Per-level displacement tables for the DIRECTION_TABLE engine.
+  // Row d holds the (dx, dy) of a depth-d sub-curve (its chord) for each heading;
+  // row 0 is a single segment. Each row has 2 * HEADINGS entries, the second
+  // half repeating the first, so heading + offset needs no modulo.
+  std::vector<double> tableDx;
+  std::vector<double> tableDy;
+
+  // Block templates for the table engine: for each heading, the displacements
+  // of the 4^blockLevel segments of one block, stored back to back.
+  int blockLevel;
+  std::vector<double> blocksDx;
+  std::vector<double> blocksDy;
+
+  // Heading of each segment of a block relative to the block's heading. It
+  // depends only on blockLevel, so it is kept from curve to curve.
+  int patternLevel;               // blockLevel the pattern was built for; -1 = none.
+  std::vector<int> blockPattern;
+
+  // Lattice templates: for each heading, the lattice coordinates of the end of
+  // every segment of a block, relative to the block's start.
+  std::vector<std::int32_t> latticeA;
+  std::vector<std::int32_t> latticeB;
   // Prevent copying of the Koch object   
   Koch(const Koch&) = delete;
   Koch& operator=(const Koch&) = delete;
@@ -59,6 +178,61 @@ private:
   // Implements the core Koch curve logic.
   void drawKoch(int level, double length);
 
+  // Appends one curve to the sink as its own path (moveto ... stroke).
+  void drawCurve(int level, double x1, double y1, double x2, double y2, PathSink& sink);
+
+  // Fills tableDx/tableDy for depths 0..level of a curve with the given
+  // base angle (degrees) and level-0 length.
+  void buildDirectionTable(int level, double angleDeg, double length);
+
+  // Sets blockLevel for sub-curves of the given depth and builds its pattern.
+  void buildBlockPattern(int depth);
+
+  // Fills the block templates for sub-curves of the given depth.
+  void buildBlockTemplates(int depth);
+
+  // Fills the lattice templates for sub-curves of the given depth.
+  void buildLatticeTemplates(int depth);
+
+  // Lattice generation of a whole level-'level' curve from (x1, y1) to (x2, y2).
+  void drawKochLattice(int level, PathSink& sink, double x1, double y1, double x2, double y2);
+
+  // Emits a depth-'depth' sub-curve starting in the given heading (0-5).
+  void emitSubcurve(int depth, int heading, PathSink& sink) const;
+
+  // Iterative table-driven generation of a whole level-'level' curve from (x, y).
+  void drawKochTable(int level, PathSink& sink, double x, double y);
+
+  // How a sub-curve's bounding triangle meets the viewport
+  enum Coverage {
+    OUTSIDE,
+    PARTIAL,
+    INSIDE
+  };
+
+  // Classifies the sub-curve starting at (x, y) with chord (cx, cy).
+  Coverage viewportCoverage(double x, double y, double cx, double cy) const;
+
+  // Emits the visible part of a depth-'depth' sub-curve starting at (x, y).
+  // 'connected' is true while the sink's pen is at (x, y).
+  void clipSubcurve(int depth, int heading, double x, double y, PathSink& sink, bool& connected) const;
+
+  // Emits the visible part of one segment (Liang-Barsky clipping).
+  void clipSegment(double x, double y, double dx, double dy, PathSink& sink, bool& connected) const;
+
+  // Table-driven generation split across the worker threads.
+  void drawKochParallel(int level, PathSink& sink, double x, double y);
+
+  // Inner loop of the lattice engine for one axis (see Koch.cpp).
+  static void latticeBlock(const std::int32_t* __restrict offsetA, const std::int32_t* __restrict offsetB,
+    std::size_t count, double startA, double startB, double origin, double u, double v,
+    double* __restrict point, double* __restrict step);
+
+  // Inner loop of the table engine: out[j] = row[pattern[j]] for both axes.
+  static void fillBlock(const double* __restrict rowDx, const double* __restrict rowDy,
+    const int* __restrict pattern, std::size_t count,
+    double* __restrict outDx, double* __restrict outDy);
+
 public:
   // Destructor for manual cleanup   
   ~Koch();
@@ -66,11 +240,49 @@ public:
   // Constructor: Initializes the Koch object.
   Koch();
 
+  // Deepest level the LATTICE engine supports (lattice coordinates stay exact as doubles)
+  static const int MAX_LATTICE_LEVEL = 33;
+
+  // Selects the generation engine. The default is RECURSIVE.
+  void setEngine(Engine e);
+
+  // Sends later curves to the given sink instead of standard output.
+  // The sink must outlive its use; nullptr restores standard output.
+  void setOutput(PathSink* sink);
+
+  // Sets the number of threads the DIRECTION_TABLE engine uses (default 1).
+  // Parallel output is identical to serial output.
+  void setThreads(int count);
+
+  // Sets the level of detail: a sub-curve whose base is at most minLength page
+  // units long is drawn as one straight segment instead of being subdivided.
+  // A raster backend passes its pixel size. 0 (the default) draws every level.
+  void setDetail(double minLength);
+
+  // Restricts generation to the rectangle [minX, maxX] x [minY, maxY] (page
+  // units). Parts of the curve outside it are skipped and segments crossing
+  // its edge are clipped, leaving gaps in the path. Uses the table engine on
+  // one thread whatever the engine setting. Throws std::invalid_argument if
+  // the rectangle is empty.
+  void setViewport(double minX, double minY, double maxX, double maxY);
+
+  // Removes the viewport: the whole curve is generated again.
+  void clearViewport();
+
+  // Level actually generated for a curve of the given level and base length,
+  // after the level-of-detail limit.
+  int detailLevel(int level, double length) const;
+
   // Main public method to generate the curve.
   // x1, y1: Start point of the level 0 segment.
   // x2, y2: End point of the level 0 segment.
   // level: The desired level of the Koch curve iteration.
   void generateCurve(int level, double x1, double y1, double x2, double y2);
+
+  // Generates many curves into one document, one stroked path per job, in order.
+  // Per-level work is shared between curves (see drawCurve), so a batch costs
+  // little more than its segments.
+  void generateBatch(const std::vector<KochJob>& jobs);
 };
 
 #endif // KOCH_H
\ No newline at end of file
@@ -0,0 +1,521 @@
+// KochOutput.cpp
+// Scott Elliott
+//
+// Description:
+// Implementation of the buffered output classes and the PostScript, SVG and
+// binary path writers.
+//
+
+#include "KochOutput.h"
+#include <charconv>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+
+#ifdef _WIN32
+#include <io.h>
+#define KOCH_WRITE _write
+#define KOCH_OPEN _open
+#define KOCH_CLOSE _close
+#define KOCH_OPEN_FLAGS (_O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY)
+#else
+#include <unistd.h>
+#define KOCH_WRITE ::write
+#define KOCH_OPEN ::open
+#define KOCH_CLOSE ::close
+#define KOCH_OPEN_FLAGS (O_WRONLY | O_CREAT | O_TRUNC)
+#endif
+
+namespace {
+
+// Longest "%.3f" text of a finite double: sign, 309 integer digits, point, 3 decimals
+const std::size_t MAX_NUMBER_CHARS = 320;
+
+// Longest "dx dy rlineto\n" line
+const std::size_t MAX_LINE_CHARS = 2 * MAX_NUMBER_CHARS + 16;
+
+// Formats value like printf("%.3f") at p and returns the end of the text.
+// p must have room for MAX_NUMBER_CHARS bytes.
+inline char* formatCoordinate(char* p, double value) {
+  return std::to_chars(p, p + MAX_NUMBER_CHARS, value, std::chars_format::fixed, 3).ptr;
+}
+
+// Segments written per reserve() by the compact writers, which bounds the
+// space reserved at once
+const std::size_t SEGMENTS_PER_RESERVE = 1024;
+
+// Longest SVG number pair: space, sign, 16 digits, point, 3 decimals, twice
+const std::size_t MAX_SVG_PAIR_CHARS = 48;
+
+// SVG pairs per line of path data
+const int SVG_PAIRS_PER_LINE = 16;
+
+// Longest varint: 64 bits in 7-bit groups
+const std::size_t MAX_VARINT_BYTES = 10;
+
+// Page height in grid units, for flipping y in SVG
+const std::int64_t PAGE_UNITS = 600 * std::int64_t(QuantizedPen::QUANTUM);
+
+static_assert(QuantizedPen::QUANTUM == 1000, "formatUnits writes three decimals");
+
+// Formats grid units as the shortest decimal in page units: no zero before
+// the point and none at the end ("-1.25", ".5", "3").
+inline char* formatUnits(char* p, std::int64_t units) {
+  std::uint64_t magnitude = static_cast<std::uint64_t>(units);
+  if (units < 0) {
+    *p++ = '-';
+    magnitude = 0 - magnitude;
+  }
+  const std::uint64_t whole = magnitude / 1000;
+  unsigned fraction = static_cast<unsigned>(magnitude % 1000);
+  if (whole != 0 || fraction == 0) {
+    p = std::to_chars(p, p + 20, whole).ptr;
+  }
+  if (fraction != 0) {
+    *p++ = '.';
+    for (unsigned place = 100; fraction != 0; place /= 10) {
+      *p++ = static_cast<char>('0' + fraction / place);
+      fraction %= place;
+    }
+  }
+  return p;
+}
+
+// Writes v as an LEB128 varint at p.
+inline char* putVarint(char* p, std::uint64_t v) {
+  while (v >= 0x80) {
+    *p++ = static_cast<char>(v | 0x80);
+    v >>= 7;
+  }
+  *p++ = static_cast<char>(v);
+  return p;
+}
+
+// Zigzag encoding: small negative and positive values both get small codes.
+inline std::uint64_t zigzag(std::int64_t v) {
+  return (static_cast<std::uint64_t>(v) << 1) ^ static_cast<std::uint64_t>(v >> 63);
+}
+
+} // namespace
+
+// --- Implementation of ByteOutput ---
+
+// Constructor
+ByteOutput::ByteOutput(std::size_t capacity)
+  : buffer(new char[capacity]), position(nullptr), limit(nullptr) {
+  position = buffer;
+  limit = buffer + capacity;
+}
+
+// Destructor
+ByteOutput::~ByteOutput() {
+  delete[] buffer;
+}
+
+// Returns space for size bytes, emptying the buffer first if it is too full.
+char* ByteOutput::reserve(std::size_t size) {
+  if (static_cast<std::size_t>(limit - position) < size) {
+    flush();
+  }
+  return position;
+}
+
+// Appends raw bytes, passing blocks larger than the buffer straight through.
+void ByteOutput::append(const char* data, std::size_t size) {
+  if (static_cast<std::size_t>(limit - position) < size) {
+    flush();
+    if (static_cast<std::size_t>(limit - buffer) < size) {
+      writeChunk(data, size);
+      return;
+    }
+  }
+  std::memcpy(position, data, size);
+  position += size;
+}
+
+// Hands buffered bytes to the destination and resets the buffer.
+void ByteOutput::flush() {
+  if (position != buffer) {
+    std::size_t size = static_cast<std::size_t>(position - buffer);
+    position = buffer;
+    writeChunk(buffer, size);
+  }
+}
+
+// --- Implementation of FileOutput ---
+
+// Constructor for an existing descriptor
+FileOutput::FileOutput(int descriptor, std::size_t capacity)
+  : ByteOutput(capacity), fd(descriptor), ownsFd(false) {
+}
+
+// Constructor that opens a file
+FileOutput::FileOutput(const std::string& path, std::size_t capacity)
+  : ByteOutput(capacity), fd(KOCH_OPEN(path.c_str(), KOCH_OPEN_FLAGS, 0644)), ownsFd(true) {
+  if (fd < 0) {
+    throw std::runtime_error("cannot open '" + path + "': " + std::strerror(errno));
+  }
+}
+
+// Destructor
+// Errors cannot be reported from here; call flush() first to see them.
+FileOutput::~FileOutput() {
+  try {
+    flush();
+  }
+  catch (...) {
+  }
+  if (ownsFd) {
+    KOCH_CLOSE(fd);
+  }
+}
+
+// Writes the whole chunk, continuing after partial writes and interrupts.
+void FileOutput::writeChunk(const char* data, std::size_t size) {
+  while (size > 0) {
+    // Windows _write takes an unsigned int count; stay well below its limit
+    unsigned int part = static_cast<unsigned int>(size < (1u << 30) ? size : (1u << 30));
+    auto written = KOCH_WRITE(fd, data, part);
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throw std::runtime_error(std::string("write failed: ") + std::strerror(errno));
+    }
+    data += written;
+    size -= static_cast<std::size_t>(written);
+  }
+}
+
+// --- Implementation of MemoryOutput ---
+
+// Constructor
+MemoryOutput::MemoryOutput(std::size_t capacity) : ByteOutput(capacity) {
+}
+
+// Destructor: nothing to flush to; unread bytes are simply dropped.
+MemoryOutput::~MemoryOutput() {
+}
+
+// Collects one chunk.
+void MemoryOutput::writeChunk(const char* data, std::size_t size) {
+  contents.append(data, size);
+}
+
+// Flushes and returns the collected bytes.
+const std::string& MemoryOutput::str() {
+  flush();
+  return contents;
+}
+
+#ifdef KOCH_WITH_ZLIB
+// --- Implementation of GzipOutput ---
+
+// Constructor: windowBits 15 + 16 selects the gzip container.
+GzipOutput::GzipOutput(ByteOutput& output, int level, std::size_t capacity)
+  : ByteOutput(capacity), destination(output), stream(), closed(false) {
+  if (deflateInit2(&stream, level, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+    throw std::runtime_error("cannot initialize gzip compression");
+  }
+}
+
+// Destructor
+GzipOutput::~GzipOutput() {
+  try {
+    close();
+  }
+  catch (...) {
+  }
+  deflateEnd(&stream);
+}
+
+// Compresses the input zlib holds, writing the output straight into the
+// destination's buffer.
+void GzipOutput::deflateInto(int mode) {
+  const std::size_t window = 64 * 1024;
+  int result;
+  do {
+    char* out = destination.reserve(window);
+    stream.next_out = reinterpret_cast<Bytef*>(out);
+    stream.avail_out = static_cast<uInt>(window);
+    result = deflate(&stream, mode);
+    if (result == Z_STREAM_ERROR) {
+      throw std::runtime_error("gzip compression failed");
+    }
+    destination.commit(out + (window - stream.avail_out));
+  } while (stream.avail_out == 0 || (mode == Z_FINISH && result != Z_STREAM_END));
+}
+
+// Feeds one chunk of text to the compressor.
+void GzipOutput::writeChunk(const char* data, std::size_t size) {
+  stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data));
+  stream.avail_in = static_cast<uInt>(size);
+  deflateInto(Z_NO_FLUSH);
+}
+
+// Compresses what is left, writes the trailer and flushes the destination.
+void GzipOutput::close() {
+  if (closed) {
+    return;
+  }
+  flush();
+  stream.next_in = nullptr;
+  stream.avail_in = 0;
+  deflateInto(Z_FINISH);
+  closed = true;
+  destination.flush();
+}
+#endif // KOCH_WITH_ZLIB
+
+// --- Implementation of PostScriptWriter ---
+
+// Constructor
+PostScriptWriter::PostScriptWriter(ByteOutput& output) : out(output), headerWritten(false) {
+}
+
+// Outputs the header (first path only) and 'moveto'.
+void PostScriptWriter::beginPath(double x, double y) {
+  if (!headerWritten) {
+    out.append("%!PS-Adobe-2.0\n%%BoundingBox: 0 0 600 600\n");
+    headerWritten = true;
+  }
+  moveTo(x, y);
+}
+
+// Outputs one 'rlineto' line per segment.
+void PostScriptWriter::lines(const double* dx, const double* dy, std::size_t count) {
+  for (std::size_t i = 0; i < count; ++i) {
+    char* p = out.reserve(MAX_LINE_CHARS);
+    p = formatCoordinate(p, dx[i]);
+    *p++ = ' ';
+    p = formatCoordinate(p, dy[i]);
+    std::memcpy(p, " rlineto\n", 9);
+    out.commit(p + 9);
+  }
+}
+
+// Outputs a 'moveto' inside the current path, which starts a new subpath.
+void PostScriptWriter::moveTo(double x, double y) {
+  char* p = out.reserve(MAX_LINE_CHARS);
+  p = formatCoordinate(p, x);
+  *p++ = ' ';
+  p = formatCoordinate(p, y);
+  std::memcpy(p, " moveto\n", 8);
+  out.commit(p + 8);
+}
+
+// Outputs 'stroke' to render the path.
+void PostScriptWriter::endPath() {
+  out.append("stroke\n");
+}
+
+// Outputs 'showpage' and pushes everything to the destination.
+void PostScriptWriter::finish() {
+  out.append("showpage\n");
+  out.flush();
+}
+
+// Creates a piece writer with its own memory buffer. The piece continues the
+// current path, so it writes neither header nor moveto; PostScript segments
+// are relative, so the start point is not needed.
+std::unique_ptr<PathSink> PostScriptWriter::fork(double x, double y) {
+  (void)x;
+  (void)y;
+  std::unique_ptr<MemoryOutput> text(new MemoryOutput());
+  std::unique_ptr<PostScriptWriter> piece(new PostScriptWriter(*text));
+  piece->headerWritten = true;
+  piece->pieceText = std::move(text);
+  return std::unique_ptr<PathSink>(piece.release());
+}
+
+// Copies a finished piece's text into the document.
+void PostScriptWriter::join(PathSink& piece) {
+  const std::string& text = static_cast<PostScriptWriter&>(piece).pieceText->str();
+  out.append(text.data(), text.size());
+}
+
+// --- Implementation of QuantizedPen ---
+
+// Reports a position the grid cannot hold.
+void QuantizedPen::outOfRange() {
+  throw std::range_error("coordinate too large for quantized output");
+}
+
+// --- Implementation of SvgWriter ---
+
+// Constructor
+SvgWriter::SvgWriter(ByteOutput& output)
+  : out(output), headerWritten(false), lastCommand('M'), separated(true),
+  pairsOnLine(0) {
+}
+
+// Opens the document; the view box matches the PostScript bounding box.
+void SvgWriter::writeHeader() {
+  if (!headerWritten) {
+    out.append("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+      "<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"600\" height=\"600\" viewBox=\"0 0 600 600\">\n");
+    headerWritten = true;
+  }
+}
+
+// Numbers are separated by a space, or by the minus sign of the next number.
+char* SvgWriter::formatPair(char* p, std::int64_t a, std::int64_t b) {
+  if (!separated && a >= 0) {
+    *p++ = ' ';
+  }
+  p = formatUnits(p, a);
+  if (b >= 0) {
+    *p++ = ' ';
+  }
+  p = formatUnits(p, b);
+  separated = false;
+  return p;
+}
+
+// Opens a <path> element with an absolute 'M'.
+void SvgWriter::beginPath(double x, double y) {
+  writeHeader();
+  std::int64_t stepX;
+  std::int64_t stepY;
+  pen.moveTo(x, y, stepX, stepY);
+  out.append("<path fill=\"none\" stroke=\"black\" d=\"M");
+  separated = true;
+  char* p = out.reserve(MAX_SVG_PAIR_CHARS);
+  p = formatPair(p, pen.unitsX(), PAGE_UNITS - pen.unitsY());
+  out.commit(p);
+  lastCommand = 'M';
+}
+
+// Writes relative pairs. After 'l' or 'm' further pairs are implicit
+// relative lines, so the command letter is only needed after 'M'.
+void SvgWriter::lines(const double* dx, const double* dy, std::size_t count) {
+  std::int64_t stepX;
+  std::int64_t stepY;
+  while (count > 0) {
+    const std::size_t n = count < SEGMENTS_PER_RESERVE ? count : SEGMENTS_PER_RESERVE;
+    char* p = out.reserve(1 + n * (MAX_SVG_PAIR_CHARS + 1));
+    if (lastCommand == 'M') {
+      *p++ = 'l';
+      lastCommand = 'l';
+      separated = true;
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+      pen.step(dx[i], dy[i], stepX, stepY);
+      p = formatPair(p, stepX, -stepY);
+      if (++pairsOnLine == SVG_PAIRS_PER_LINE) {
+        *p++ = '\n';
+        separated = true;
+        pairsOnLine = 0;
+      }
+    }
+    out.commit(p);
+    dx += n;
+    dy += n;
+    count -= n;
+  }
+}
+
+// Writes a relative 'm' that leaves a gap.
+void SvgWriter::moveTo(double x, double y) {
+  std::int64_t stepX;
+  std::int64_t stepY;
+  pen.moveTo(x, y, stepX, stepY);
+  char* p = out.reserve(1 + MAX_SVG_PAIR_CHARS);
+  *p++ = 'm';
+  separated = true;
+  p = formatPair(p, stepX, -stepY);
+  out.commit(p);
+  lastCommand = 'm';
+}
+
+// Closes the <path> element.
+void SvgWriter::endPath() {
+  out.append("\"/>\n");
+  separated = true;
+  pairsOnLine = 0;
+}
+
+// Closes the document and pushes everything to the destination.
+void SvgWriter::finish() {
+  writeHeader();
+  out.append("</svg>\n");
+  out.flush();
+}
+
+// --- Implementation of BinaryPathWriter ---
+
+// Constructor
+BinaryPathWriter::BinaryPathWriter(ByteOutput& output) : out(output), headerWritten(false) {
+}
+
+// Writes the magic, version and grid once.
+void BinaryPathWriter::writeHeader() {
+  if (!headerWritten) {
+    char* p = out.reserve(5 + MAX_VARINT_BYTES);
+    std::memcpy(p, "KPTH\x01", 5);
+    p = putVarint(p + 5, QuantizedPen::QUANTUM);
+    out.commit(p);
+    headerWritten = true;
+  }
+}
+
+// MOVE record with the absolute start.
+void BinaryPathWriter::beginPath(double x, double y) {
+  writeHeader();
+  std::int64_t stepX;
+  std::int64_t stepY;
+  pen.moveTo(x, y, stepX, stepY);
+  char* p = out.reserve(1 + 2 * MAX_VARINT_BYTES);
+  *p++ = static_cast<char>(MOVE);
+  p = putVarint(p, zigzag(pen.unitsX()));
+  p = putVarint(p, zigzag(pen.unitsY()));
+  out.commit(p);
+}
+
+// One LINES record per SEGMENTS_PER_RESERVE segments.
+void BinaryPathWriter::lines(const double* dx, const double* dy, std::size_t count) {
+  std::int64_t stepX;
+  std::int64_t stepY;
+  while (count > 0) {
+    const std::size_t n = count < SEGMENTS_PER_RESERVE ? count : SEGMENTS_PER_RESERVE;
+    char* p = out.reserve(1 + MAX_VARINT_BYTES + n * 2 * MAX_VARINT_BYTES);
+    *p++ = static_cast<char>(LINES);
+    p = putVarint(p, n);
+    for (std::size_t i = 0; i < n; ++i) {
+      pen.step(dx[i], dy[i], stepX, stepY);
+      p = putVarint(p, zigzag(stepX));
+      p = putVarint(p, zigzag(stepY));
+    }
+    out.commit(p);
+    dx += n;
+    dy += n;
+    count -= n;
+  }
+}
+
+// GAP record with the relative jump.
+void BinaryPathWriter::moveTo(double x, double y) {
+  std::int64_t stepX;
+  std::int64_t stepY;
+  pen.moveTo(x, y, stepX, stepY);
+  char* p = out.reserve(1 + 2 * MAX_VARINT_BYTES);
+  *p++ = static_cast<char>(GAP);
+  p = putVarint(p, zigzag(stepX));
+  p = putVarint(p, zigzag(stepY));
+  out.commit(p);
+}
+
+// END record.
+void BinaryPathWriter::endPath() {
+  const char record = static_cast<char>(END);
+  out.append(&record, 1);
+}
+
+// DONE record; pushes everything to the destination.
+void BinaryPathWriter::finish() {
+  writeHeader();
+  const char record = static_cast<char>(DONE);
+  out.append(&record, 1);
+  out.flush();
+}
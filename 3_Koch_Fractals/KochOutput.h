@@ -0,0 +1,340 @@
+// KochOutput.h
+// Scott Elliott
+//
+// Description:
+// Output backends for the Koch curve generator.
+// A PathSink receives the curve as a start point followed by batches of relative
+// line segments. PostScriptWriter turns them into the same PostScript text the
+// original iostream code printed, formatting numbers with std::to_chars into a
+// large reusable buffer that ByteOutput writes out in big chunks, with no
+// per-line flush. When built with -DKOCH_WITH_ZLIB, GzipOutput compresses the
+// chunks on their way to another ByteOutput.
+//
+// SvgWriter and BinaryPathWriter are compact alternatives to PostScript. Both
+// round positions to the same 0.001 grid the PostScript text uses and emit the
+// differences of rounded positions: SVG as short relative path commands,
+// the binary format as variable-length integers (about 2 bytes a segment).
+//
+
+#ifndef KOCH_OUTPUT_H
+#define KOCH_OUTPUT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <memory>
+
+#ifdef KOCH_WITH_ZLIB
+#include <zlib.h>
+#endif
+
+// --- Class: ByteOutput ---
+// Description: Buffered byte stream. Callers format text directly into the buffer
+// (reserve / commit); full buffers are handed to writeChunk. Derived classes must
+// call flush() in their destructor, since writeChunk cannot be reached from here.
+class ByteOutput {
+private:
+  char* buffer;         // Start of the reusable buffer.
+  char* position;       // Next free byte.
+  char* limit;          // One past the end of the buffer.
+
+  // Prevent copying of the buffer
+  ByteOutput(const ByteOutput&) = delete;
+  ByteOutput& operator=(const ByteOutput&) = delete;
+
+protected:
+  // Writes one chunk of bytes to the destination. Throws std::runtime_error on failure.
+  virtual void writeChunk(const char* data, std::size_t size) = 0;
+
+public:
+  // Default buffer size: 1 MiB
+  static const std::size_t DEFAULT_CAPACITY = 1 << 20;
+
+  // Constructor: Allocates a buffer of the given size.
+  explicit ByteOutput(std::size_t capacity = DEFAULT_CAPACITY);
+
+  // Destructor: Frees the buffer (without flushing; see the class description).
+  virtual ~ByteOutput();
+
+  // Returns a pointer to at least size free bytes, flushing first if needed.
+  // size must not exceed the buffer capacity.
+  char* reserve(std::size_t size);
+
+  // Marks the bytes up to end (obtained from reserve) as written.
+  void commit(char* end) { position = end; }
+
+  // Appends raw bytes.
+  void append(const char* data, std::size_t size);
+  void append(const char* text) { append(text, std::strlen(text)); }
+
+  // Hands all buffered bytes to writeChunk.
+  void flush();
+
+  // Flushes and ends the stream (e.g. writes a compression trailer).
+  // Nothing may be written afterwards.
+  virtual void close() { flush(); }
+};
+
+// --- Class: FileOutput ---
+// Description: ByteOutput that writes to a file descriptor with write(2).
+// Either wraps an existing descriptor (e.g. standard output) or opens a file.
+class FileOutput : public ByteOutput {
+private:
+  int fd;               // Destination descriptor.
+  bool ownsFd;          // True if the descriptor was opened here and must be closed.
+
+protected:
+  void writeChunk(const char* data, std::size_t size) override;
+
+public:
+  // Writes to an already open descriptor, which is left open.
+  explicit FileOutput(int descriptor, std::size_t capacity = DEFAULT_CAPACITY);
+
+  // Creates or truncates the named file. Throws std::runtime_error on failure.
+  explicit FileOutput(const std::string& path, std::size_t capacity = DEFAULT_CAPACITY);
+
+  // Destructor: Flushes remaining bytes and closes an owned descriptor.
+  ~FileOutput() override;
+};
+
+#ifdef KOCH_WITH_ZLIB
+// --- Class: GzipOutput ---
+// Description: ByteOutput that gzip-compresses its chunks into another ByteOutput
+// (typically a FileOutput). close() must be called to write the gzip trailer.
+class GzipOutput : public ByteOutput {
+private:
+  ByteOutput& destination;  // Receives the compressed bytes.
+  z_stream stream;          // zlib deflate state.
+  bool closed;              // True once the trailer has been written.
+
+  // Runs deflate over the pending input with the given flush mode.
+  void deflateInto(int mode);
+
+protected:
+  void writeChunk(const char* data, std::size_t size) override;
+
+public:
+  // Constructor: level is the zlib compression level (1 fastest .. 9 smallest).
+  explicit GzipOutput(ByteOutput& output, int level = 6, std::size_t capacity = DEFAULT_CAPACITY);
+
+  // Destructor: Closes the stream if close() was not called (errors are lost).
+  ~GzipOutput() override;
+
+  // Compresses the remaining bytes and writes the gzip trailer.
+  void close() override;
+};
+#endif // KOCH_WITH_ZLIB
+
+// --- Class: MemoryOutput ---
+// Description: ByteOutput that keeps everything written in memory.
+class MemoryOutput : public ByteOutput {
+private:
+  std::string contents;   // Bytes flushed so far.
+
+protected:
+  void writeChunk(const char* data, std::size_t size) override;
+
+public:
+  // Smaller default buffer: memory outputs are usually short-lived pieces
+  explicit MemoryOutput(std::size_t capacity = 64 * 1024);
+  ~MemoryOutput() override;
+
+  // Flushes and returns everything written so far.
+  const std::string& str();
+};
+
+// --- Class: PathSink ---
+// Description: Receives a curve as drawing commands. Coordinates are doubles; the
+// sink decides how they are encoded.
+class PathSink {
+public:
+  virtual ~PathSink() {}
+
+  // Starts a path at the absolute point (x, y).
+  virtual void beginPath(double x, double y) = 0;
+
+  // Appends count relative segments (dx[i], dy[i]) to the current path.
+  virtual void lines(const double* dx, const double* dy, std::size_t count) = 0;
+
+  // Continues the current path at the absolute point (x, y) without drawing,
+  // leaving a gap (used where a viewport clips the path).
+  virtual void moveTo(double x, double y) = 0;
+
+  // Ends (strokes) the current path.
+  virtual void endPath() = 0;
+
+  // Completes the document and flushes it.
+  virtual void finish() = 0;
+
+  // --- Parallel generation ---
+  // A sink that can fork hands out independent sinks for consecutive pieces of
+  // the current path; they are filled concurrently and joined back in path order.
+
+  // True if fork() is supported.
+  virtual bool canFork() const { return false; }
+
+  // Creates a sink for a piece of the current path starting at the absolute
+  // point (x, y). Must be safe to call from several threads at once.
+  virtual std::unique_ptr<PathSink> fork(double x, double y) { (void)x; (void)y; return nullptr; }
+
+  // Appends a finished piece created by fork() to this sink's path.
+  virtual void join(PathSink& piece) { (void)piece; }
+};
+
+// --- Class: PostScriptWriter ---
+// Description: PathSink producing PostScript with coordinates printed to three
+// decimal places ("%.3f"), byte-identical to the std::fixed / setprecision(3) output.
+// The header is written at the first beginPath.
+class PostScriptWriter : public PathSink {
+private:
+  ByteOutput& out;      // Destination for the text.
+  bool headerWritten;   // True once the PostScript header is out.
+  std::unique_ptr<MemoryOutput> pieceText;  // Own buffer of a forked piece.
+
+public:
+  // Constructor: Writes into the given output, which must outlive the writer.
+  explicit PostScriptWriter(ByteOutput& output);
+
+  void beginPath(double x, double y) override;
+  void lines(const double* dx, const double* dy, std::size_t count) override;
+  void moveTo(double x, double y) override;
+  void endPath() override;
+  void finish() override;
+
+  // Pieces render into memory and are copied into the document on join.
+  bool canFork() const override { return true; }
+  std::unique_ptr<PathSink> fork(double x, double y) override;
+  void join(PathSink& piece) override;
+};
+
+// --- Class: QuantizedPen ---
+// Description: Pen position in page units and on the output grid of 1 / QUANTUM
+// page units. Each step is reported as the difference of two rounded absolute
+// positions, so rounding errors do not add up along the path.
+class QuantizedPen {
+private:
+  double x;             // Exact position (page units).
+  double y;
+  std::int64_t unitX;   // Rounded position (grid units).
+  std::int64_t unitY;
+
+  // Throws std::range_error for a position too far out for the grid.
+  [[noreturn]] static void outOfRange();
+
+  // Rounds to the nearest grid unit (ties to even). Adding and subtracting
+  // 1.5 * 2^52 rounds any double below 2^51 to an integer in two instructions.
+  static std::int64_t quantize(double value) {
+    const double LIMIT = 2251799813685248.0;    // 2^51
+    const double ROUNDER = 6755399441055744.0;  // 1.5 * 2^52
+    double units = value * QUANTUM;
+    if (!(units < LIMIT && units > -LIMIT)) {
+      outOfRange();
+    }
+    return static_cast<std::int64_t>((units + ROUNDER) - ROUNDER);
+  }
+
+public:
+  // Grid units per page unit (three decimals, like the PostScript text)
+  static const int QUANTUM = 1000;
+
+  QuantizedPen() : x(0.0), y(0.0), unitX(0), unitY(0) {}
+
+  // Rounded position.
+  std::int64_t unitsX() const { return unitX; }
+  std::int64_t unitsY() const { return unitY; }
+
+  // Jumps to (px, py); returns the move in grid units.
+  void moveTo(double px, double py, std::int64_t& stepX, std::int64_t& stepY) {
+    std::int64_t nx = quantize(px);
+    std::int64_t ny = quantize(py);
+    stepX = nx - unitX;
+    stepY = ny - unitY;
+    x = px;
+    y = py;
+    unitX = nx;
+    unitY = ny;
+  }
+
+  // Moves by (dx, dy); returns the move in grid units. Inline: runs per segment.
+  void step(double dx, double dy, std::int64_t& stepX, std::int64_t& stepY) {
+    moveTo(x + dx, y + dy, stepX, stepY);
+  }
+};
+
+// --- Class: SvgWriter ---
+// Description: PathSink that writes an SVG document, one <path> element per
+// path. The first point is absolute ('M'); segments are relative 'l' pairs and
+// gaps relative 'm' moves, with numbers in the shortest form (".5", "-1.25").
+// The page is 600 x 600 like the PostScript bounding box, flipped because SVG
+// y grows downwards. Serial only: the pen is tracked along the whole path.
+class SvgWriter : public PathSink {
+private:
+  ByteOutput& out;      // Destination for the text.
+  bool headerWritten;   // True once the <svg> element is open.
+  QuantizedPen pen;     // Position in page coordinates (y up).
+  char lastCommand;     // Last path command written: 'M', 'm' or 'l'.
+  bool separated;       // True if the next number needs no leading space.
+  int pairsOnLine;      // Pairs written since the last line break.
+
+  // Writes the XML header and the opening <svg> tag once.
+  void writeHeader();
+
+  // Formats a pair of grid-unit numbers at p; p needs room for 48 bytes.
+  char* formatPair(char* p, std::int64_t a, std::int64_t b);
+
+public:
+  // Constructor: Writes into the given output, which must outlive the writer.
+  explicit SvgWriter(ByteOutput& output);
+
+  void beginPath(double x, double y) override;
+  void lines(const double* dx, const double* dy, std::size_t count) override;
+  void moveTo(double x, double y) override;
+  void endPath() override;
+  void finish() override;
+};
+
+// --- Class: BinaryPathWriter ---
+// Description: PathSink that writes a compact binary path file. All numbers
+// are LEB128 varints (7 bits a byte, low bits first); coordinates are grid
+// units (1 / QuantizedPen::QUANTUM page units, y up), signed values zigzag
+// encoded ((v << 1) ^ (v >> 63)). Layout:
+//   "KPTH", version byte 1, varint QUANTUM
+//   records, each starting with a type byte:
+//     1 MOVE   x, y        absolute start of a path
+//     2 GAP    dx, dy      jump within the path without drawing
+//     3 LINES  n, then n pairs dx, dy
+//     4 END    end of the path
+//     0 DONE   end of the document
+// Serial only: the pen is tracked along the whole path.
+class BinaryPathWriter : public PathSink {
+public:
+  // Record types
+  enum Record {
+    DONE = 0,
+    MOVE = 1,
+    GAP = 2,
+    LINES = 3,
+    END = 4
+  };
+
+private:
+  ByteOutput& out;      // Destination for the bytes.
+  bool headerWritten;   // True once the file header is out.
+  QuantizedPen pen;     // Position in grid units.
+
+  // Writes the file header once.
+  void writeHeader();
+
+public:
+  // Constructor: Writes into the given output, which must outlive the writer.
+  explicit BinaryPathWriter(ByteOutput& output);
+
+  void beginPath(double x, double y) override;
+  void lines(const double* dx, const double* dy, std::size_t count) override;
+  void moveTo(double x, double y) override;
+  void endPath() override;
+  void finish() override;
+};
+
+#endif // KOCH_OUTPUT_H
@@ -0,0 +1,207 @@
+// KochPipeline.cpp
+// Scott Elliott
+//
+// Description:
+// Implementation of the pipelined output stage: the ring protocol on the
+// generator side and the writer thread.
+//
+// Synchronization: the generator publishes a batch by storing 'produced', the
+// writer frees one by storing 'consumed'; each side only reads the other's
+// counter, so the ring itself needs no lock. A side that finds the ring empty
+// (writer) or full (generator) spins briefly, then sets its waiting flag and
+// sleeps on the condition variable; the other side checks that flag after
+// every store and wakes it. Flags and counters use sequentially consistent
+// operations so that a store and the other side's flag check cannot both miss.
+//
+
+#include "KochPipeline.h"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+
+// Checks of the other side's counter before falling back to sleeping
+const int SPIN_LIMIT = 256;
+
+} // namespace
+
+// --- Implementation of PipelineSink ---
+
+// Constructor
+PipelineSink::PipelineSink(PathSink& sink, std::size_t batches, std::size_t segmentsPerBatch)
+  : downstream(sink), batchSize(segmentsPerBatch), produced(0), consumed(0), current(nullptr),
+  writerWaiting(false), producerWaiting(false), failed(false) {
+  if (batches < 2 || segmentsPerBatch < 1) {
+    throw std::invalid_argument("pipeline needs at least 2 batches of at least 1 segment");
+  }
+  ring.resize(batches);
+  ringDx.resize(batches * segmentsPerBatch);
+  ringDy.resize(batches * segmentsPerBatch);
+  writer = std::thread(&PipelineSink::run, this);
+}
+
+// Destructor
+// Reached without finish() when generation failed: the pending batch becomes
+// a STOP so nothing more reaches the downstream sink.
+PipelineSink::~PipelineSink() {
+  if (writer.joinable()) {
+    try {
+      if (current == nullptr) {
+        open(STOP, 0.0, 0.0);
+      }
+      current->command = STOP;
+      current->count = 0;
+      publish();
+    }
+    catch (...) {
+      // The writer already stopped with an error
+    }
+    writer.join();
+  }
+}
+
+// Rethrows the writer's error on the generator thread.
+void PipelineSink::checkFailure() {
+  if (failed.load()) {
+    std::rethrow_exception(failure);
+  }
+}
+
+// Claims the next slot, waiting while the ring is full.
+void PipelineSink::open(Command command, double x, double y) {
+  const std::size_t position = produced.load(std::memory_order_relaxed);
+  auto hasRoom = [&]() { return position - consumed.load() < ring.size(); };
+  for (int spin = 0; spin < SPIN_LIMIT && !hasRoom() && !failed.load(); ++spin) {
+  }
+  if (!hasRoom()) {
+    std::unique_lock<std::mutex> guard(lock);
+    producerWaiting.store(true);
+    wake.wait(guard, [&]() { return hasRoom() || failed.load(); });
+    producerWaiting.store(false);
+  }
+  checkFailure();
+
+  current = &ring[position % ring.size()];
+  current->command = command;
+  current->x = x;
+  current->y = y;
+  current->count = 0;
+}
+
+// Hands the filled batch to the writer.
+void PipelineSink::publish() {
+  if (current == nullptr) {
+    return;
+  }
+  current = nullptr;
+  produced.store(produced.load(std::memory_order_relaxed) + 1);
+  if (writerWaiting.load()) {
+    std::lock_guard<std::mutex> guard(lock);
+    wake.notify_all();
+  }
+}
+
+// Each path command starts a new batch that its segments then fill.
+void PipelineSink::beginPath(double x, double y) {
+  publish();
+  open(BEGIN, x, y);
+}
+
+// Copies segments into the current batch, starting a new one when it is full.
+void PipelineSink::lines(const double* dx, const double* dy, std::size_t count) {
+  while (count > 0) {
+    if (current == nullptr || current->count == batchSize) {
+      publish();
+      open(NONE, 0.0, 0.0);
+    }
+    const std::size_t offset = static_cast<std::size_t>(current - ring.data()) * batchSize + current->count;
+    const std::size_t n = std::min(count, batchSize - current->count);
+    std::memcpy(&ringDx[offset], dx, n * sizeof(double));
+    std::memcpy(&ringDy[offset], dy, n * sizeof(double));
+    current->count += n;
+    dx += n;
+    dy += n;
+    count -= n;
+  }
+}
+
+void PipelineSink::moveTo(double x, double y) {
+  publish();
+  open(MOVE, x, y);
+}
+
+void PipelineSink::endPath() {
+  publish();
+  open(END, 0.0, 0.0);
+}
+
+// Sends FINISH and waits for the writer to complete the document.
+void PipelineSink::finish() {
+  publish();
+  open(FINISH, 0.0, 0.0);
+  publish();
+  writer.join();
+  checkFailure();
+}
+
+// Writer thread: replays batches into the downstream sink in order.
+void PipelineSink::run() {
+  std::size_t position = 0;
+  for (;;) {
+    auto hasBatch = [&]() { return produced.load() != position; };
+    for (int spin = 0; spin < SPIN_LIMIT && !hasBatch(); ++spin) {
+    }
+    if (!hasBatch()) {
+      std::unique_lock<std::mutex> guard(lock);
+      writerWaiting.store(true);
+      wake.wait(guard, hasBatch);
+      writerWaiting.store(false);
+    }
+
+    const std::size_t slot = position % ring.size();
+    const Batch& batch = ring[slot];
+    bool last = false;
+    try {
+      switch (batch.command) {
+      case BEGIN:
+        downstream.beginPath(batch.x, batch.y);
+        break;
+      case MOVE:
+        downstream.moveTo(batch.x, batch.y);
+        break;
+      case END:
+        downstream.endPath();
+        break;
+      case FINISH:
+        downstream.finish();
+        last = true;
+        break;
+      case STOP:
+        last = true;
+        break;
+      case NONE:
+        break;
+      }
+      if (batch.count > 0) {
+        downstream.lines(&ringDx[slot * batchSize], &ringDy[slot * batchSize], batch.count);
+      }
+    }
+    catch (...) {
+      failure = std::current_exception();
+      failed.store(true);
+      std::lock_guard<std::mutex> guard(lock);
+      wake.notify_all();
+      return;
+    }
+
+    consumed.store(++position);
+    if (producerWaiting.load()) {
+      std::lock_guard<std::mutex> guard(lock);
+      wake.notify_all();
+    }
+    if (last) {
+      return;
+    }
+  }
+}
@@ -0,0 +1,109 @@
+// KochPipeline.h
+// Scott Elliott
+//
+// Description:
+// Pipelined output stage for the Koch curve generator. PipelineSink is a PathSink
+// that sits in front of another sink (PostScript, SVG, raster, ...) and hands the
+// path to a writer thread, so generating segments and formatting/writing them
+// overlap. Segments are collected into fixed-size batches that live in a
+// single-producer/single-consumer ring: the generator fills a batch in place and
+// publishes it with one atomic store, the writer thread replays published batches
+// into the downstream sink in order. Memory is bounded by the ring size, and a
+// full ring makes the generator wait for the writer.
+//
+
+#ifndef KOCH_PIPELINE_H
+#define KOCH_PIPELINE_H
+
+#include "KochOutput.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// --- Class: PipelineSink ---
+// Description: Forwards every call to a downstream sink on a writer thread.
+// The downstream sink is only used by the writer thread until finish() returns.
+// Errors thrown by the downstream sink are rethrown to the generator from a
+// later call or from finish().
+class PipelineSink : public PathSink {
+private:
+  // Path command carried by a batch, applied before the batch's segments
+  enum Command {
+    NONE,       // Segments only
+    BEGIN,      // beginPath(x, y)
+    MOVE,       // moveTo(x, y)
+    END,        // endPath()
+    FINISH,     // finish(), then the writer stops
+    STOP        // The writer stops without finishing (generation failed)
+  };
+
+  // One slot of the ring
+  struct Batch {
+    Command command;
+    double x;
+    double y;
+    std::size_t count;  // Segments used in this batch's part of dx/dy.
+  };
+
+  PathSink& downstream;             // Receives the path on the writer thread.
+  const std::size_t batchSize;      // Segments per batch.
+  std::vector<Batch> ring;          // Slots; slot i uses segments [i * batchSize, (i + 1) * batchSize).
+  std::vector<double> ringDx;
+  std::vector<double> ringDy;
+
+  // Ring positions count batches since the start; slot = position % ring.size().
+  // The generator owns 'produced', the writer owns 'consumed'.
+  std::atomic<std::size_t> produced;  // Batches published by the generator.
+  std::atomic<std::size_t> consumed;  // Batches completed by the writer.
+  Batch* current;                     // Batch being filled, not yet published; nullptr if none.
+
+  // Blocking fallback for an empty or full ring
+  std::mutex lock;
+  std::condition_variable wake;
+  std::atomic<bool> writerWaiting;    // Writer is (about to be) blocked on an empty ring.
+  std::atomic<bool> producerWaiting;  // Generator is (about to be) blocked on a full ring.
+
+  std::atomic<bool> failed;           // Set by the writer when the downstream sink throws.
+  std::exception_ptr failure;         // The writer's error; read after 'failed' is seen.
+  std::thread writer;                 // Writer thread.
+
+  // Prevent copying of the pipeline
+  PipelineSink(const PipelineSink&) = delete;
+  PipelineSink& operator=(const PipelineSink&) = delete;
+
+  // Generator side: waits for a free slot and starts filling it.
+  void open(Command command, double x, double y);
+
+  // Generator side: publishes the batch being filled, if any.
+  void publish();
+
+  // Generator side: rethrows the writer's error, if any.
+  void checkFailure();
+
+  // Writer thread body: replays batches until FINISH or STOP.
+  void run();
+
+public:
+  // Constructor: Starts the writer thread. The ring holds 'batches' batches of
+  // 'segmentsPerBatch' segments (at least 2 and 1). The downstream sink must
+  // outlive the pipeline.
+  explicit PipelineSink(PathSink& sink, std::size_t batches = 8, std::size_t segmentsPerBatch = 4096);
+
+  // Destructor: Stops the writer thread if finish() was not reached.
+  ~PipelineSink();
+
+  void beginPath(double x, double y) override;
+  void lines(const double* dx, const double* dy, std::size_t count) override;
+  void moveTo(double x, double y) override;
+  void endPath() override;
+
+  // Sends the rest of the path, waits for the writer to finish the document
+  // and rethrows its error, if any.
+  void finish() override;
+};
+
+#endif // KOCH_PIPELINE_H
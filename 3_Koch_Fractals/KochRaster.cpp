@@ -0,0 +1,267 @@
+// KochRaster.cpp
+// Scott Elliott
+//
+// Description:
+// Implementation of the framebuffer, the line kernel and the PPM/PNG writers.
+//
+
+#include "KochRaster.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+// Far-off coordinates are pinned to this range so the conversion to int is
+// always defined; such points are off the image anyway.
+const double PIXEL_LIMIT = 1 << 24;
+
+inline int clampToPixel(double value) {
+  return static_cast<int>(std::max(-PIXEL_LIMIT, std::min(PIXEL_LIMIT, std::floor(value))));
+}
+
+// --- PNG helpers ---
+
+// CRC-32 (polynomial 0xEDB88320) used by PNG chunks
+std::uint32_t crc32Update(std::uint32_t crc, const unsigned char* data, std::size_t size) {
+  static std::uint32_t table[256];
+  static bool tableReady = false;
+  if (!tableReady) {
+    for (std::uint32_t n = 0; n < 256; ++n) {
+      std::uint32_t c = n;
+      for (int k = 0; k < 8; ++k) {
+        c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+      }
+      table[n] = c;
+    }
+    tableReady = true;
+  }
+  for (std::size_t i = 0; i < size; ++i) {
+    crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+  }
+  return crc;
+}
+
+// Appends a 32-bit big-endian integer
+void putBigEndian(std::vector<unsigned char>& bytes, std::uint32_t value) {
+  bytes.push_back(static_cast<unsigned char>(value >> 24));
+  bytes.push_back(static_cast<unsigned char>(value >> 16));
+  bytes.push_back(static_cast<unsigned char>(value >> 8));
+  bytes.push_back(static_cast<unsigned char>(value));
+}
+
+// Writes one PNG chunk: length, type, data, CRC of type and data
+void writeChunk(ByteOutput& out, const char* type, const std::vector<unsigned char>& data) {
+  std::vector<unsigned char> head;
+  putBigEndian(head, static_cast<std::uint32_t>(data.size()));
+  head.insert(head.end(), type, type + 4);
+  std::uint32_t crc = crc32Update(0xFFFFFFFFu, head.data() + 4, 4);
+  crc = crc32Update(crc, data.data(), data.size()) ^ 0xFFFFFFFFu;
+  std::vector<unsigned char> tail;
+  putBigEndian(tail, crc);
+  out.append(reinterpret_cast<const char*>(head.data()), head.size());
+  out.append(reinterpret_cast<const char*>(data.data()), data.size());
+  out.append(reinterpret_cast<const char*>(tail.data()), tail.size());
+}
+
+// Wraps raw bytes in a zlib stream. Without zlib the data goes into stored
+// (uncompressed) deflate blocks, which every PNG reader accepts.
+std::vector<unsigned char> zlibWrap(const std::vector<unsigned char>& raw) {
+#ifdef KOCH_WITH_ZLIB
+  uLongf size = compressBound(static_cast<uLong>(raw.size()));
+  std::vector<unsigned char> packed(size);
+  if (compress2(packed.data(), &size, raw.data(), static_cast<uLong>(raw.size()), Z_BEST_SPEED) != Z_OK) {
+    throw std::runtime_error("PNG compression failed");
+  }
+  packed.resize(size);
+  return packed;
+#else
+  const std::size_t MAX_STORED = 65535;
+  std::vector<unsigned char> packed;
+  packed.reserve(raw.size() + raw.size() / MAX_STORED * 5 + 16);
+  packed.push_back(0x78);   // Deflate, 32K window
+  packed.push_back(0x01);   // No preset dictionary; header checksum
+  std::size_t offset = 0;
+  do {
+    std::size_t size = std::min(MAX_STORED, raw.size() - offset);
+    bool last = offset + size == raw.size();
+    packed.push_back(last ? 1 : 0);
+    packed.push_back(static_cast<unsigned char>(size));
+    packed.push_back(static_cast<unsigned char>(size >> 8));
+    packed.push_back(static_cast<unsigned char>(~size));
+    packed.push_back(static_cast<unsigned char>(~size >> 8));
+    packed.insert(packed.end(), raw.begin() + offset, raw.begin() + offset + size);
+    offset += size;
+  } while (offset < raw.size());
+
+  // Adler-32 of the uncompressed data
+  std::uint32_t a = 1;
+  std::uint32_t b = 0;
+  for (std::size_t i = 0; i < raw.size(); ) {
+    std::size_t run = std::min<std::size_t>(5552, raw.size() - i);  // Largest run without overflow
+    for (std::size_t end = i + run; i < end; ++i) {
+      a += raw[i];
+      b += a;
+    }
+    a %= 65521;
+    b %= 65521;
+  }
+  putBigEndian(packed, (b << 16) | a);
+  return packed;
+#endif
+}
+
+} // namespace
+
+// --- Implementation of Raster ---
+
+// Constructor
+Raster::Raster(int w, int h) : width(w), height(h) {
+  if (w <= 0 || h <= 0) {
+    throw std::invalid_argument("raster size must be positive");
+  }
+  pixels.assign(static_cast<std::size_t>(w) * h, 255);
+}
+
+// Bresenham's line algorithm: integer steps only, one pixel per step along
+// the major axis. Lines entirely outside the image are skipped up front;
+// others are clipped per pixel.
+void Raster::drawLine(int x0, int y0, int x1, int y1) {
+  if ((x0 < 0 && x1 < 0) || (y0 < 0 && y1 < 0) ||
+    (x0 >= width && x1 >= width) || (y0 >= height && y1 >= height)) {
+    return;
+  }
+  const int dx = std::abs(x1 - x0);
+  const int dy = -std::abs(y1 - y0);
+  const int stepX = x0 < x1 ? 1 : -1;
+  const int stepY = y0 < y1 ? 1 : -1;
+  int error = dx + dy;
+  for (;;) {
+    if (x0 >= 0 && x0 < width && y0 >= 0 && y0 < height) {
+      pixels[static_cast<std::size_t>(y0) * width + x0] = 0;
+    }
+    if (x0 == x1 && y0 == y1) {
+      break;
+    }
+    const int twice = 2 * error;
+    if (twice >= dy) {
+      error += dy;
+      x0 += stepX;
+    }
+    if (twice <= dx) {
+      error += dx;
+      y0 += stepY;
+    }
+  }
+}
+
+// Writes a binary PPM: gray pixels are repeated for R, G and B.
+void Raster::writePPM(ByteOutput& out) const {
+  std::string header = "P6\n" + std::to_string(width) + " " + std::to_string(height) + "\n255\n";
+  out.append(header.data(), header.size());
+  const std::size_t rowBytes = static_cast<std::size_t>(width) * 3;
+  for (int y = 0; y < height; ++y) {
+    const unsigned char* row = &pixels[static_cast<std::size_t>(y) * width];
+    char* p = out.reserve(rowBytes);
+    for (int x = 0; x < width; ++x) {
+      p[0] = p[1] = p[2] = static_cast<char>(row[x]);
+      p += 3;
+    }
+    out.commit(p);
+  }
+}
+
+// Writes a PNG: signature, IHDR, one IDAT holding every row (filter type 0), IEND.
+void Raster::writePNG(ByteOutput& out) const {
+  static const unsigned char SIGNATURE[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+  out.append(reinterpret_cast<const char*>(SIGNATURE), sizeof(SIGNATURE));
+
+  std::vector<unsigned char> header;
+  putBigEndian(header, static_cast<std::uint32_t>(width));
+  putBigEndian(header, static_cast<std::uint32_t>(height));
+  header.push_back(8);    // Bit depth
+  header.push_back(0);    // Color type: grayscale
+  header.push_back(0);    // Compression: deflate
+  header.push_back(0);    // Filter method: adaptive
+  header.push_back(0);    // Interlace: none
+  writeChunk(out, "IHDR", header);
+
+  std::vector<unsigned char> raw;
+  raw.reserve(static_cast<std::size_t>(width + 1) * height);
+  for (int y = 0; y < height; ++y) {
+    raw.push_back(0);     // Filter: none
+    const unsigned char* row = &pixels[static_cast<std::size_t>(y) * width];
+    raw.insert(raw.end(), row, row + width);
+  }
+  writeChunk(out, "IDAT", zlibWrap(raw));
+  writeChunk(out, "IEND", std::vector<unsigned char>());
+}
+
+// --- Implementation of RasterSink ---
+
+// Constructor
+RasterSink::RasterSink(ByteOutput& output, int width, int height, Format fileFormat)
+  : out(output), format(fileFormat), raster(width, height),
+  scaleX(static_cast<double>(width) / PAGE_SIZE), scaleY(static_cast<double>(height) / PAGE_SIZE),
+  penX(0.0), penY(0.0) {
+}
+
+// Page units per pixel; the coarser axis decides what is below a pixel.
+double RasterSink::pixelSize() const {
+  return 1.0 / std::min(scaleX, scaleY);
+}
+
+// Page x to pixel column
+int RasterSink::toPixelX(double x) const {
+  return clampToPixel(x * scaleX);
+}
+
+// Page y to pixel row (row 0 is the top of the page)
+int RasterSink::toPixelY(double y) const {
+  return clampToPixel((PAGE_SIZE - y) * scaleY);
+}
+
+// Moves the pen to the path's start point.
+void RasterSink::beginPath(double x, double y) {
+  penX = x;
+  penY = y;
+}
+
+// Draws each segment from the pen position. Endpoints are rounded from the
+// accumulated page position, so rounding errors never build up along the path.
+void RasterSink::lines(const double* dx, const double* dy, std::size_t count) {
+  int px = toPixelX(penX);
+  int py = toPixelY(penY);
+  for (std::size_t i = 0; i < count; ++i) {
+    penX += dx[i];
+    penY += dy[i];
+    int nx = toPixelX(penX);
+    int ny = toPixelY(penY);
+    raster.drawLine(px, py, nx, ny);
+    px = nx;
+    py = ny;
+  }
+}
+
+// Moves the pen without drawing.
+void RasterSink::moveTo(double x, double y) {
+  penX = x;
+  penY = y;
+}
+
+// Nothing to do: segments are drawn as they arrive.
+void RasterSink::endPath() {
+}
+
+// Encodes the image and flushes it.
+void RasterSink::finish() {
+  if (format == PNG) {
+    raster.writePNG(out);
+  }
+  else {
+    raster.writePPM(out);
+  }
+  out.flush();
+}
@@ -0,0 +1,93 @@
+// KochRaster.h
+// Scott Elliott
+//
+// Description:
+// Built-in rasterizer for the Koch curve generator. RasterSink is a PathSink that
+// draws each segment straight into an 8-bit grayscale framebuffer with an integer
+// Bresenham line kernel, then writes the image as binary PPM or PNG. This avoids
+// piping PostScript through Ghostscript. The page is the same 600 x 600 point
+// area the PostScript bounding box declares, scaled to the image size.
+//
+
+#ifndef KOCH_RASTER_H
+#define KOCH_RASTER_H
+
+#include "KochOutput.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// --- Class: Raster ---
+// Description: Grayscale framebuffer, one byte per pixel, row 0 at the top.
+class Raster {
+private:
+  int width;                          // Image width in pixels.
+  int height;                         // Image height in pixels.
+  std::vector<unsigned char> pixels;  // width * height intensities, 255 = white.
+
+public:
+  // Constructor: Creates a white image. Throws std::invalid_argument for empty sizes.
+  Raster(int w, int h);
+
+  int getWidth() const { return width; }
+  int getHeight() const { return height; }
+
+  // Reads a pixel; coordinates must be inside the image.
+  unsigned char pixel(int x, int y) const { return pixels[static_cast<std::size_t>(y) * width + x]; }
+
+  // Draws a black line between two pixel centers, clipped to the image.
+  void drawLine(int x0, int y0, int x1, int y1);
+
+  // Writes the image as binary PPM (P6).
+  void writePPM(ByteOutput& out) const;
+
+  // Writes the image as an 8-bit grayscale PNG. Pixel data is deflate-compressed
+  // when built with KOCH_WITH_ZLIB and stored uncompressed otherwise.
+  void writePNG(ByteOutput& out) const;
+};
+
+// --- Class: RasterSink ---
+// Description: PathSink that rasterizes the path and writes the image in finish().
+// Combine with Koch::setDetail(sink.pixelSize()) so sub-pixel detail is not generated.
+class RasterSink : public PathSink {
+public:
+  // Image file formats
+  enum Format {
+    PPM,
+    PNG
+  };
+
+private:
+  ByteOutput& out;      // Destination for the image file.
+  Format format;        // Image file format.
+  Raster raster;        // Framebuffer.
+  double scaleX;        // Pixels per page unit, horizontally.
+  double scaleY;        // Pixels per page unit, vertically.
+  double penX;          // Current point in page units.
+  double penY;
+
+  // Converts page coordinates to the nearest pixel (y flipped: page y grows up).
+  int toPixelX(double x) const;
+  int toPixelY(double y) const;
+
+public:
+  // Page size mapped onto the image (matches the PostScript bounding box)
+  static const int PAGE_SIZE = 600;
+
+  // Constructor: The output must outlive the sink.
+  RasterSink(ByteOutput& output, int width, int height, Format fileFormat);
+
+  // Size of one pixel in page units (the larger of the two axes).
+  double pixelSize() const;
+
+  // Read access to the framebuffer.
+  const Raster& image() const { return raster; }
+
+  void beginPath(double x, double y) override;
+  void lines(const double* dx, const double* dy, std::size_t count) override;
+  void moveTo(double x, double y) override;
+  void endPath() override;
+  void finish() override;
+};
+
+#endif // KOCH_RASTER_H
@@ -0,0 +1,313 @@
+// LSystem.cpp
+// Scott Elliott
+//
+// Description:
+// Implementation of the LSystem class: rule compilation, curve measurement
+// (for fitting the curve between two points) and the bytecode expander.
+//
+
+#include "LSystem.h"
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+// --- Compilation ---
+
+// Constructor
+LSystem::LSystem(const std::string& axiom, const std::map<char, std::string>& rules,
+  double angleDeg, const std::string& drawSymbols)
+  : angle(angleDeg), divisions(0) {
+  // Headings are integers, so the angle must split the full turn evenly
+  double steps = 360.0 / angleDeg;
+  if (!(angleDeg > 0.0) || std::fabs(steps - std::round(steps)) > 1e-9 || steps > 360.0) {
+    throw std::invalid_argument("L-system angle must divide 360 degrees");
+  }
+  divisions = static_cast<int>(std::round(steps));
+
+  for (int h = 0; h < divisions; ++h) {
+    double radians = h * angle * M_PI / 180.0;
+    unitX.push_back(std::cos(radians));
+    unitY.push_back(std::sin(radians));
+  }
+
+  // Number the rules, then compile their bodies against that numbering
+  std::map<char, int> ruleIndex;
+  for (const auto& rule : rules) {
+    int index = static_cast<int>(ruleIndex.size());
+    ruleIndex[rule.first] = index;
+    ruleDraws.push_back(drawSymbols.find(rule.first) != std::string::npos);
+  }
+  for (const auto& rule : rules) {
+    code.push_back(compile(rule.second, ruleIndex, drawSymbols));
+  }
+  axiomCode = compile(axiom, ruleIndex, drawSymbols);
+}
+
+// Translates symbols to instructions. Runs of turns collapse into one TURN
+// (dropped if they cancel out); symbols that neither draw, turn nor have a
+// rule are dropped.
+std::vector<LSystem::Instruction> LSystem::compile(const std::string& body,
+  const std::map<char, int>& ruleIndex, const std::string& drawSymbols) const {
+  std::vector<Instruction> program;
+  int pendingTurn = 0;
+
+  auto flushTurn = [&]() {
+    pendingTurn %= divisions;
+    if (pendingTurn != 0) {
+      program.push_back(Instruction{ TURN, pendingTurn });
+    }
+    pendingTurn = 0;
+  };
+
+  for (char symbol : body) {
+    if (symbol == '+') {
+      pendingTurn += 1;
+    }
+    else if (symbol == '-') {
+      pendingTurn += divisions - 1;
+    }
+    else if (symbol == '|') {
+      if (divisions % 2 != 0) {
+        throw std::invalid_argument("'|' needs an angle that divides 180 degrees");
+      }
+      pendingTurn += divisions / 2;
+    }
+    else {
+      auto rule = ruleIndex.find(symbol);
+      if (rule != ruleIndex.end()) {
+        flushTurn();
+        program.push_back(Instruction{ CALL, rule->second });
+      }
+      else if (drawSymbols.find(symbol) != std::string::npos) {
+        flushTurn();
+        program.push_back(Instruction{ DRAW, 0 });
+      }
+    }
+  }
+  flushTurn();
+  return program;
+}
+
+// --- Measurement ---
+
+// Shape of a sequence: follows the instructions, rotating each sub-shape into
+// the current heading instead of expanding it.
+LSystem::Shape LSystem::walk(const std::vector<Instruction>& sequence, int times,
+  const std::vector<std::vector<Shape>>& shapes, bool firstMoveOnly) const {
+  Shape result = { 0.0, 0.0, 0 };
+  for (const Instruction& in : sequence) {
+    if (in.op == TURN) {
+      result.turn = (result.turn + in.arg) % divisions;
+      continue;
+    }
+    const Shape step = (in.op == CALL) ? shapes[times][in.arg] : Shape{ 1.0, 0.0, 0 };
+    const double c = unitX[result.turn];
+    const double s = unitY[result.turn];
+    result.x += c * step.x - s * step.y;
+    result.y += s * step.x + c * step.y;
+    result.turn = (result.turn + step.turn) % divisions;
+    if (firstMoveOnly && (step.x != 0.0 || step.y != 0.0)) {
+      break;
+    }
+  }
+  return result;
+}
+
+// Builds shapes[k][r] for k = 0..maxDepth. A symbol expanded 0 times is one
+// unit step if it draws and nothing otherwise.
+std::vector<std::vector<LSystem::Shape>> LSystem::measure(int maxDepth) const {
+  std::vector<std::vector<Shape>> shapes(maxDepth + 1, std::vector<Shape>(code.size()));
+  for (std::size_t r = 0; r < code.size(); ++r) {
+    shapes[0][r] = ruleDraws[r] ? Shape{ 1.0, 0.0, 0 } : Shape{ 0.0, 0.0, 0 };
+  }
+  for (int k = 1; k <= maxDepth; ++k) {
+    for (std::size_t r = 0; r < code.size(); ++r) {
+      shapes[k][r] = walk(code[r], k - 1, shapes, false);
+    }
+  }
+  return shapes;
+}
+
+// Counts segments level by level like measure(), saturating instead of overflowing.
+std::uint64_t LSystem::segmentCount(int depth) const {
+  const std::uint64_t MAX = std::numeric_limits<std::uint64_t>::max();
+  auto add = [MAX](std::uint64_t a, std::uint64_t b) { return (a > MAX - b) ? MAX : a + b; };
+  auto countOf = [&](const std::vector<Instruction>& sequence, const std::vector<std::uint64_t>& below) {
+    std::uint64_t total = 0;
+    for (const Instruction& in : sequence) {
+      if (in.op == CALL) {
+        total = add(total, below[in.arg]);
+      }
+      else if (in.op == DRAW) {
+        total = add(total, 1);
+      }
+    }
+    return total;
+  };
+
+  std::vector<std::uint64_t> counts(code.size());
+  for (std::size_t r = 0; r < code.size(); ++r) {
+    counts[r] = ruleDraws[r] ? 1 : 0;
+  }
+  for (int k = 1; k <= depth; ++k) {
+    std::vector<std::uint64_t> next(code.size());
+    for (std::size_t r = 0; r < code.size(); ++r) {
+      next[r] = countOf(code[r], counts);
+    }
+    counts.swap(next);
+  }
+  return countOf(axiomCode, counts);
+}
+
+// --- Generation ---
+
+// Bytecode interpreter. The stack holds one frame per rule being expanded, so
+// it never holds more than depth + 1 frames. A CALL in a frame with levels to
+// spare pushes the rule's body; in the last frame it is a leaf and draws if its
+// symbol does. Segments are batched and passed to the sink a chunk at a time.
+// With a compile-time Divisions the heading wrap is a constant compare.
+template <int Divisions>
+void LSystem::expand(int depth, const double* dirX, const double* dirY, PathSink& sink) const {
+  struct Frame {
+    const Instruction* pc;
+    const Instruction* end;
+    int depth;
+  };
+  const int headings = Divisions ? Divisions : divisions;
+  const std::size_t CHUNK = 4096;
+  double chunkX[CHUNK];
+  double chunkY[CHUNK];
+  std::size_t pending = 0;
+  int heading = 0;
+
+  std::vector<Frame> stack;
+  stack.reserve(depth + 1);
+  stack.push_back(Frame{ axiomCode.data(), axiomCode.data() + axiomCode.size(), depth });
+
+  while (!stack.empty()) {
+    Frame& frame = stack.back();
+    if (frame.pc == frame.end) {
+      stack.pop_back();
+      continue;
+    }
+    const Instruction in = *frame.pc++;
+    if (in.op == TURN) {
+      heading += in.arg;
+      if (heading >= headings) {
+        heading -= headings;
+      }
+      continue;
+    }
+    if (in.op == CALL) {
+      if (frame.depth > 0) {
+        const std::vector<Instruction>& body = code[in.arg];
+        stack.push_back(Frame{ body.data(), body.data() + body.size(), frame.depth - 1 });
+        continue;
+      }
+      if (!ruleDraws[in.arg]) {
+        continue;
+      }
+    }
+    chunkX[pending] = dirX[heading];
+    chunkY[pending] = dirY[heading];
+    if (++pending == CHUNK) {
+      sink.lines(chunkX, chunkY, pending);
+      pending = 0;
+    }
+  }
+  if (pending > 0) {
+    sink.lines(chunkX, chunkY, pending);
+  }
+}
+
+// Fits the curve between the two points, builds the per-heading step table
+// and runs the expander specialized for the heading count.
+void LSystem::generate(int depth, double x1, double y1, double x2, double y2, PathSink& sink) const {
+  if (depth < 0) {
+    throw std::invalid_argument("L-system depth must be non-negative");
+  }
+  std::vector<std::vector<Shape>> shapes = measure(depth);
+  Shape fit = walk(axiomCode, depth, shapes, false);
+  Shape firstSide = walk(axiomCode, depth, shapes, true);
+  const double firstLength = std::hypot(firstSide.x, firstSide.y);
+  if (std::hypot(fit.x, fit.y) <= 1e-9 * firstLength) {
+    fit = firstSide;   // Closed curve: fit its first side instead
+  }
+
+  // Scale and rotation that carry the fitted vector onto (x1, y1) -> (x2, y2)
+  const double fitLength = std::hypot(fit.x, fit.y);
+  const double targetX = x2 - x1;
+  const double targetY = y2 - y1;
+  const double scale = fitLength > 0.0 ? std::hypot(targetX, targetY) / fitLength : 0.0;
+  const double rotation = std::atan2(targetY, targetX) - std::atan2(fit.y, fit.x);
+
+  std::vector<double> dirX(divisions);
+  std::vector<double> dirY(divisions);
+  for (int h = 0; h < divisions; ++h) {
+    double radians = rotation + h * angle * M_PI / 180.0;
+    dirX[h] = scale * std::cos(radians);
+    dirY[h] = scale * std::sin(radians);
+  }
+
+  sink.beginPath(x1, y1);
+  switch (divisions) {
+  case 4:
+    expand<4>(depth, dirX.data(), dirY.data(), sink);
+    break;
+  case 6:
+    expand<6>(depth, dirX.data(), dirY.data(), sink);
+    break;
+  default:
+    expand<0>(depth, dirX.data(), dirY.data(), sink);
+    break;
+  }
+  sink.endPath();
+  sink.finish();
+}
+
+// --- Presets ---
+
+// Koch curve: each segment becomes four with a 60-degree bump
+LSystem LSystem::koch() {
+  return LSystem("F", { { 'F', "F+F--F+F" } }, 60.0);
+}
+
+// Koch snowflake: three Koch curves around a triangle
+LSystem LSystem::snowflake() {
+  return LSystem("F--F--F", { { 'F', "F+F--F+F" } }, 60.0);
+}
+
+// Hilbert curve: A and B are placeholders, only F draws
+LSystem LSystem::hilbert() {
+  return LSystem("A", { { 'A', "+BF-AFA-FB+" }, { 'B', "-AF+BFB+FA-" } }, 90.0);
+}
+
+// Heighway dragon
+LSystem LSystem::dragon() {
+  return LSystem("FX", { { 'X', "X+YF+" }, { 'Y', "-FX-Y" } }, 90.0);
+}
+
+// Sierpinski arrowhead: both A and B draw
+LSystem LSystem::sierpinskiArrowhead() {
+  return LSystem("A", { { 'A', "B-A-B" }, { 'B', "A+B+A" } }, 60.0, "AB");
+}
+
+// Gosper curve (flowsnake): both A and B draw
+LSystem LSystem::gosper() {
+  return LSystem("A", { { 'A', "A-B--B+A++AA+B-" }, { 'B', "+A-BB--B-A++A+B" } }, 60.0, "AB");
+}
+
+// Preset lookup by name
+LSystem LSystem::preset(const std::string& name) {
+  if (name == "koch") return koch();
+  if (name == "snowflake") return snowflake();
+  if (name == "hilbert") return hilbert();
+  if (name == "dragon") return dragon();
+  if (name == "sierpinski") return sierpinskiArrowhead();
+  if (name == "gosper") return gosper();
+  throw std::invalid_argument("unknown curve '" + name + "'");
+}
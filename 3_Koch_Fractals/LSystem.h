@@ -0,0 +1,105 @@
+// LSystem.h
+// Scott Elliott
+//
+// Description:
+// Defines the LSystem class, a general form of the Koch generator. An L-system
+// is an axiom plus rewriting rules (e.g. Koch: F -> F+F--F+F) and a turning angle.
+// The rule set is compiled once into a compact bytecode (draw, turn by k steps,
+// expand a rule) with consecutive turns merged and non-drawing leaves dropped.
+// The bytecode is then run by an iterative expander with an explicit stack:
+//   - headings are integers modulo 360 / angle, like the Koch table engine,
+//     so each segment is one table lookup and no trigonometry;
+//   - the expander is a template on the number of headings, with compiled
+//     instantiations for 4 (90-degree curves) and 6 (60-degree curves) and a
+//     runtime fallback for other angles;
+//   - segments are handed to the same PathSink backends as Koch (PostScript, raster).
+//
+
+#ifndef LSYSTEM_H
+#define LSYSTEM_H
+
+#include "KochOutput.h"
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+class LSystem {
+private:
+  // --- Bytecode ---
+  enum OpCode {
+    CALL,   // Expand rule 'arg' (at the last level: draw if that symbol draws)
+    DRAW,   // Draw one segment (a drawing symbol with no rule)
+    TURN    // Turn left by 'arg' steps of the angle (0 < arg < divisions)
+  };
+
+  struct Instruction {
+    OpCode op;
+    int arg;
+  };
+
+  // Net effect of a symbol expanded some number of times: displacement in unit
+  // steps when started in heading 0, and the heading change (0 .. divisions-1)
+  struct Shape {
+    double x;
+    double y;
+    int turn;
+  };
+
+  std::vector<Instruction> axiomCode;           // Compiled axiom.
+  std::vector<std::vector<Instruction>> code;   // Compiled rule bodies, by rule index.
+  std::vector<bool> ruleDraws;                  // True if the rule's symbol draws.
+  double angle;                                 // Turning angle in degrees.
+  int divisions;                                // Number of headings: 360 / angle.
+  std::vector<double> unitX;                    // Unit step for each heading (heading 0 = +x).
+  std::vector<double> unitY;
+
+  // Compiles one production body or the axiom.
+  std::vector<Instruction> compile(const std::string& body, const std::map<char, int>& ruleIndex,
+    const std::string& drawSymbols) const;
+
+  // Shapes of every rule symbol expanded 0..maxDepth times (dynamic programming:
+  // each level is built from the one below without expanding anything).
+  std::vector<std::vector<Shape>> measure(int maxDepth) const;
+
+  // Shape of a compiled sequence whose symbols are expanded 'times' times.
+  // With firstMoveOnly, stops after the first instruction that moves the pen.
+  Shape walk(const std::vector<Instruction>& sequence, int times,
+    const std::vector<std::vector<Shape>>& shapes, bool firstMoveOnly) const;
+
+  // Iterative expander; Divisions == 0 reads the heading count at run time.
+  template <int Divisions>
+  void expand(int depth, const double* dirX, const double* dirY, PathSink& sink) const;
+
+public:
+  // Constructor: Compiles an L-system. 'rules' maps a symbol to its replacement.
+  // Symbols listed in drawSymbols draw a segment when they are not expanded
+  // further; '+' turns left, '-' turns right and '|' turns around; other
+  // symbols are placeholders. Throws std::invalid_argument if angleDeg does
+  // not divide 360 into a whole number of steps.
+  LSystem(const std::string& axiom, const std::map<char, std::string>& rules,
+    double angleDeg, const std::string& drawSymbols = "F");
+
+  // --- Presets ---
+  static LSystem koch();                  // Koch curve
+  static LSystem snowflake();             // Koch snowflake (closed)
+  static LSystem hilbert();               // Hilbert space-filling curve
+  static LSystem dragon();                // Heighway dragon
+  static LSystem sierpinskiArrowhead();   // Sierpinski arrowhead curve
+  static LSystem gosper();                // Gosper (flowsnake) curve
+
+  // Returns the preset with the given name (the method names above, with
+  // "sierpinski" for the arrowhead). Throws std::invalid_argument otherwise.
+  static LSystem preset(const std::string& name);
+
+  // Number of segments drawn at the given depth (saturates at UINT64_MAX).
+  std::uint64_t segmentCount(int depth) const;
+
+  // Generates the curve expanded 'depth' times, scaled and rotated so that it
+  // runs from (x1, y1) to (x2, y2). A closed curve (one that ends where it
+  // starts) is fitted by its first side instead. The complete document is
+  // written to the sink.
+  void generate(int depth, double x1, double y1, double x2, double y2, PathSink& sink) const;
+};
+
+#endif // LSYSTEM_H
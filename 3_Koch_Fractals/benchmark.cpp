@@ -0,0 +1,327 @@
+// benchmark.cpp
+// Scott Elliott
+//
+// Description:
+// Benchmark for the Koch curve generator. Sweeps levels 0 to maxLevel for each
+// engine (recursive, table, lattice) and each output backend:
+//   null     a sink that only counts segments (generation alone)
+//   buffer   the writer formats into a MemoryOutput (formatting, no I/O)
+//   file     the writer formats into a FileOutput on a temporary file
+// The buffer and file backends run once per vector format (ps, svg, bin).
+// Each result is reported as one JSON object with segments/s, bytes/s, the
+// peak resident set size of the run and a split of the time per curve:
+//   recursion_seconds  walking the curve's structure with integer headings
+//                      only: the same 4^level call tree as Koch::drawKoch for
+//                      the recursive engine, a KochSegmentIterator over the
+//                      blocks handed to the sink for the block engines
+//   math_seconds       the rest of generation (null backend time minus recursion):
+//                      tables, templates and the coordinate arithmetic
+//   output_seconds     the rest of the run (this backend minus the null backend)
+// The parts are estimates from separate runs and are clamped at 0.
+// Each measurement repeats the curve until it has run for at least 0.1 s. An
+// (engine, backend, format) combination stops at the level whose next run is
+// predicted to exceed the time budget.
+//
+// Compilation: g++ -std=c++17 -O2 -pthread -o koch_benchmark benchmark.cpp Koch.cpp KochOutput.cpp KochRaster.cpp LSystem.cpp KochPipeline.cpp -lm
+// Execution:   ./koch_benchmark [maxLevel] [budgetSeconds] > results.json
+//              (defaults: 10, 5; the buffer backend holds a whole document in memory)
+//
+
+#include "Koch.h"
+#include "KochOutput.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+namespace {
+
+// ============================================================================
+// MEASUREMENT
+// ============================================================================
+
+using Clock = std::chrono::steady_clock;
+
+double since(Clock::time_point start) {
+  return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// Shortest time a measurement repeats its run for
+const double MIN_SECONDS = 0.1;
+
+// Runs fn until MIN_SECONDS have passed (at least once); returns seconds per run.
+double timeRuns(const std::function<void()>& fn) {
+  int runs = 0;
+  Clock::time_point start = Clock::now();
+  double elapsed = 0.0;
+  do {
+    fn();
+    ++runs;
+    elapsed = since(start);
+  } while (elapsed < MIN_SECONDS);
+  return elapsed / runs;
+}
+
+// Peak RSS is read from /proc on Linux. Writing 5 to clear_refs resets the
+// peak to the current RSS (after returning freed heap to the system), so each
+// run reports its own peak; if that fails the value is the process-wide peak
+// so far. Other systems report -1.
+void resetPeakRss() {
+#ifdef __GLIBC__
+  malloc_trim(0);
+#endif
+#ifdef __linux__
+  std::ofstream clear("/proc/self/clear_refs");
+  clear << "5" << std::flush;
+#endif
+}
+
+long peakRssKb() {
+#ifdef __linux__
+  std::ifstream status("/proc/self/status");
+  std::string field;
+  while (status >> field) {
+    if (field == "VmHWM:") {
+      long kb = -1;
+      status >> kb;
+      return kb;
+    }
+    status.ignore(4096, '\n');
+  }
+#endif
+  return -1;
+}
+
+// Keeps the structure walks from being optimized out
+std::uint64_t checksum = 0;
+
+// ============================================================================
+// SINKS AND STRUCTURE WALKS
+// ============================================================================
+
+// --- Class: NullSink ---
+// Description: Counts the segments it is given and drops them. Also records
+// the largest lines() call, which is the block size of the block engines.
+class NullSink : public PathSink {
+public:
+  std::uint64_t segments = 0;
+  std::size_t largest = 0;
+
+  void beginPath(double, double) override {}
+  void lines(const double*, const double*, std::size_t count) override {
+    segments += count;
+    largest = std::max(largest, count);
+  }
+  void moveTo(double, double) override {}
+  void endPath() override {}
+  void finish() override {}
+};
+
+// The call tree of Koch::drawKoch with an integer heading and no arithmetic
+void walkTree(int level, int heading) {
+  if (level == 0) {
+    checksum += static_cast<std::uint64_t>(heading);
+    return;
+  }
+  walkTree(level - 1, heading);
+  walkTree(level - 1, (heading + 1) % 6);
+  walkTree(level - 1, (heading + 5) % 6);
+  walkTree(level - 1, heading);
+}
+
+// The block loop of the table and lattice engines without the blocks
+void walkBlocks(int depth) {
+  for (KochSegmentIterator it(depth); !it.done(); it.next()) {
+    checksum += static_cast<std::uint64_t>(it.heading());
+  }
+}
+
+// ============================================================================
+// RUNS
+// ============================================================================
+
+struct Engine {
+  const char* name;
+  Koch::Engine engine;
+};
+
+const Engine ENGINES[] = {
+  { "recursive", Koch::RECURSIVE },
+  { "table", Koch::DIRECTION_TABLE },
+  { "lattice", Koch::LATTICE }
+};
+
+const char* const FORMATS[] = { "ps", "svg", "bin" };
+
+// Level 0 segment of every curve (the README example)
+const double X1 = 25.0, Y1 = 400.0, X2 = 575.0, Y2 = 400.0;
+
+std::unique_ptr<PathSink> makeWriter(const std::string& format, ByteOutput& output) {
+  if (format == "svg") return std::unique_ptr<PathSink>(new SvgWriter(output));
+  if (format == "bin") return std::unique_ptr<PathSink>(new BinaryPathWriter(output));
+  return std::unique_ptr<PathSink>(new PostScriptWriter(output));
+}
+
+void generate(Koch::Engine engine, int level, PathSink& sink) {
+  Koch koch;
+  koch.setEngine(engine);
+  koch.setOutput(&sink);
+  koch.generateCurve(level, X1, Y1, X2, Y2);
+}
+
+struct Result {
+  double seconds;         // Per curve
+  std::uint64_t bytes;    // Document size
+  long peakKb;            // Peak RSS during the measurement
+};
+
+// Generation into the null sink; also returns the sink's counts.
+Result runNull(Koch::Engine engine, int level, NullSink& counts) {
+  resetPeakRss();
+  double seconds = timeRuns([&]() {
+    counts = NullSink();
+    generate(engine, level, counts);
+  });
+  return { seconds, 0, peakRssKb() };
+}
+
+Result runBuffer(Koch::Engine engine, int level, const std::string& format) {
+  std::uint64_t bytes = 0;
+  resetPeakRss();
+  double seconds = timeRuns([&]() {
+    MemoryOutput output;
+    std::unique_ptr<PathSink> writer = makeWriter(format, output);
+    generate(engine, level, *writer);
+    bytes = output.str().size();
+  });
+  return { seconds, bytes, peakRssKb() };
+}
+
+Result runFile(Koch::Engine engine, int level, const std::string& format, const std::string& path) {
+  resetPeakRss();
+  double seconds = timeRuns([&]() {
+    FileOutput output(path);
+    std::unique_ptr<PathSink> writer = makeWriter(format, output);
+    generate(engine, level, *writer);
+    output.flush();
+  });
+  return { seconds, std::filesystem::file_size(path), peakRssKb() };
+}
+
+// ============================================================================
+// SWEEP AND REPORTING
+// ============================================================================
+
+bool firstRecord = true;
+
+struct Split {
+  double recursion;
+  double generation;      // Null backend time: recursion + math
+};
+
+void report(const std::string& engine, const std::string& backend, const std::string& format,
+  int level, std::uint64_t segments, const Result& r, const Split& split) {
+  const double recursion = std::min(split.recursion, r.seconds);
+  const double math = std::max(0.0, std::min(split.generation, r.seconds) - recursion);
+  const double output = std::max(0.0, r.seconds - split.generation);
+  std::cout << (firstRecord ? "  " : ",\n  ")
+    << "{\"engine\": \"" << engine << "\", \"backend\": \"" << backend
+    << "\", \"format\": \"" << format << "\", \"level\": " << level
+    << ", \"segments\": " << segments << ", \"seconds\": " << r.seconds
+    << ", \"segments_per_sec\": " << segments / r.seconds
+    << ", \"bytes\": " << r.bytes << ", \"bytes_per_sec\": " << r.bytes / r.seconds
+    << ", \"peak_rss_kb\": " << r.peakKb
+    << ", \"recursion_seconds\": " << recursion << ", \"math_seconds\": " << math
+    << ", \"output_seconds\": " << output << "}";
+  firstRecord = false;
+}
+
+// Levels grow the work fourfold, so a combination whose last run took more
+// than a quarter of the budget stops there.
+bool withinBudget(double lastSeconds, double budget) {
+  return lastSeconds * 4.0 <= budget;
+}
+
+void benchEngine(const Engine& engine, int maxLevel, double budget, const std::string& path) {
+  std::cerr << "Benchmarking " << engine.name << " engine" << std::endl;
+  const std::size_t FORMAT_COUNT = sizeof(FORMATS) / sizeof(FORMATS[0]);
+  double lastNull = 0.0;
+  std::vector<double> lastBuffer(FORMAT_COUNT, 0.0);
+  std::vector<double> lastFile(FORMAT_COUNT, 0.0);
+
+  for (int level = 0; level <= maxLevel && withinBudget(lastNull, budget); ++level) {
+    NullSink counts;
+    Result null = runNull(engine.engine, level, counts);
+    lastNull = null.seconds;
+
+    // Block engines hand the sink whole blocks of 4^k segments
+    int blockDepth = 0;
+    while ((std::size_t(1) << (2 * (blockDepth + 1))) <= counts.largest) {
+      ++blockDepth;
+    }
+    Split split;
+    split.generation = null.seconds;
+    if (engine.engine == Koch::RECURSIVE) {
+      split.recursion = timeRuns([&]() { walkTree(level, 0); });
+    }
+    else {
+      split.recursion = timeRuns([&]() { walkBlocks(level - blockDepth); });
+    }
+    report(engine.name, "null", "none", level, counts.segments, null, split);
+
+    for (std::size_t f = 0; f < FORMAT_COUNT; ++f) {
+      if (withinBudget(lastBuffer[f], budget)) {
+        Result r = runBuffer(engine.engine, level, FORMATS[f]);
+        report(engine.name, "buffer", FORMATS[f], level, counts.segments, r, split);
+        lastBuffer[f] = r.seconds;
+      }
+      if (withinBudget(lastFile[f], budget)) {
+        Result r = runFile(engine.engine, level, FORMATS[f], path);
+        report(engine.name, "file", FORMATS[f], level, counts.segments, r, split);
+        lastFile[f] = r.seconds;
+      }
+    }
+  }
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+  int maxLevel = 10;
+  double budget = 5.0;
+  if (argc > 1) maxLevel = std::atoi(argv[1]);
+  if (argc > 2) budget = std::atof(argv[2]);
+  if (maxLevel < 0 || maxLevel > Koch::MAX_LATTICE_LEVEL || budget <= 0) {
+    std::cerr << "Usage: " << argv[0] << " [maxLevel 0-" << Koch::MAX_LATTICE_LEVEL
+      << "] [budgetSeconds > 0]" << std::endl;
+    return 1;
+  }
+
+  const std::string path = (std::filesystem::temp_directory_path() / "koch_benchmark.out").string();
+  try {
+    std::cout << "[\n";
+    for (const Engine& engine : ENGINES) {
+      benchEngine(engine, maxLevel, budget, path);
+    }
+    std::cout << "\n]" << std::endl;
+  }
+  catch (const std::exception& e) {
+    std::cerr << "Error: " << e.what() << std::endl;
+    std::filesystem::remove(path);
+    return 1;
+  }
+  std::filesystem::remove(path);
+
+  std::cerr << "checksum " << checksum << std::endl;
+  return 0;
+}
@@ -7,15 +7,79 @@
 // of the Koch class. The Turtle functionality is now integrated within the Koch class.
 // The program outputs Postscript commands to standard output (stdout).
 // 
-// Usage: ./koch x1 y1 x2 y2 level
+// Usage: ./koch x1 y1 x2 y2 level [options]
+//        ./koch --batch=FILE [options]   (FILE "-" reads standard input)
+// Options:
+//   --engine=recursive|table|lattice   Generation engine (default: recursive)
+//   --output=FILE              Write the PostScript to FILE instead of stdout
+//   --stream                   Streaming mode: table engine, levels up to MAX_STREAM_LEVEL
+//   --compress                 gzip the output (requires building with -DKOCH_WITH_ZLIB -lz)
+//   --threads=N                Generate with N worker threads (table engine)
+//   --format=ps|svg|bin|ppm|png  Output format (default: ps); svg and bin are compact
+//                              vector formats, ppm/png are rendered directly
+//   --size=W or WxH            Image size in pixels for ppm/png (default: 600)
+//   --curve=NAME               koch (default), or an L-system preset: snowflake,
+//                              hilbert, dragon, sierpinski, gosper
+//   --viewport=X0,Y0,X1,Y1     Only generate the part of the Koch curve inside this
+//                              rectangle; levels up to MAX_STREAM_LEVEL
+//   --pipeline                 Format and write the output on a separate writer thread
+//   --quiet                    Do not print the parameters to stderr
+//   --batch=FILE               (first argument) Draw every "x1 y1 x2 y2 level" line of
+//                              FILE as one stroke of a single document
 //
 
 #include "Koch.h"
+#include "KochOutput.h"
+#include "KochPipeline.h"
+#include "KochRaster.h"
+#include "LSystem.h"
 #include <iostream>
 #include <cstdlib> // For exit()
 #include <sstream> // For argument parsing
+#include <algorithm>
+#include <fstream>
+#include <vector>
 #include <stdexcept>
-#include <cmath>   // For pow() function
+#include <string>
+#include <memory>
+#include <cstdint>
+
+// Function: readJobs
+// Description: Reads batch jobs, one "x1 y1 x2 y2 level" per line. Blank lines
+//              and lines starting with '#' are skipped.
+// Parameters:
+//   in - The job stream.
+//   jobs - Receives the jobs in file order.
+// Return Value: true on success; false (after printing an error) on a bad line.
+static bool readJobs(std::istream& in, std::vector<KochJob>& jobs) {
+  std::string line;
+  for (int number = 1; std::getline(in, line); ++number) {
+    std::stringstream ss(line);
+    std::string first;
+    if (!(ss >> first) || first[0] == '#') {
+      continue;
+    }
+    ss.clear();
+    ss.seekg(0);
+    KochJob job;
+    ss >> job.x1 >> job.y1 >> job.x2 >> job.y2 >> job.level;
+    std::string rest;
+    if (ss.fail() || (ss >> rest)) {
+      std::cerr << "Error: Line " << number << " of the batch is not \"x1 y1 x2 y2 level\"." << std::endl;
+      return false;
+    }
+    if (job.level < 0) {
+      std::cerr << "Error: Line " << number << " of the batch has a negative level." << std::endl;
+      return false;
+    }
+    jobs.push_back(job);
+  }
+  if (in.bad()) {
+    std::cerr << "Error: Cannot read the batch file." << std::endl;
+    return false;
+  }
+  return true;
+}
 
 // Function: main
 // Description: Program entry point. Parses command-line arguments, validates input,
@@ -25,39 +89,177 @@
 //   argv - An array of C-style strings containing the arguments.
 // Return Value: 0 on success, 1 on error.
 int main(int argc, char* argv[]) {
-  // Check for correct number of arguments (program name + 5 arguments = 6 total)
-  if (argc != 6) {
+  // Batch mode: a job file replaces the five positional arguments
+  std::string batchPath;    // Empty for a single curve; "-" is standard input
+  if (argc >= 2 && std::string(argv[1]).compare(0, 8, "--batch=") == 0) {
+    batchPath = std::string(argv[1]).substr(8);
+    if (batchPath.empty()) {
+      std::cerr << "Error: --batch needs a file name (or - for standard input)." << std::endl;
+      return 1;
+    }
+  }
+
+  // Check for correct number of arguments (program name + 5 arguments = 6 total, plus options)
+  if (batchPath.empty() && argc < 6) {
     // Output error message to stderr
     std::cerr << "Error: Incorrect number of arguments." << std::endl;
-    std::cerr << "Usage: " << argv[0] << " x1 y1 x2 y2 level" << std::endl;
+    std::cerr << "Usage: " << argv[0] << " x1 y1 x2 y2 level [--engine=recursive|table|lattice] [--output=FILE] [--stream] [--compress] [--threads=N] [--format=ps|svg|bin|ppm|png] [--size=WxH] [--curve=NAME] [--viewport=X0,Y0,X1,Y1] [--pipeline] [--quiet]" << std::endl;
+    std::cerr << "   or: " << argv[0] << " --batch=FILE [options]" << std::endl;
     return 1;
   }
 
   // Variables to hold parsed input
-  double x1, y1, x2, y2;
-  int level;
+  double x1 = 0.0, y1 = 0.0, x2 = 0.0, y2 = 0.0;
+  int level = 0;
+  Koch::Engine engine = Koch::RECURSIVE;
+  std::string outputPath;   // Empty means standard output
+  bool stream = false;      // Streaming mode: lifts MAX_LEVEL
+  bool compress = false;    // gzip the output
+  int threads = 1;          // Worker threads
+  std::string format = "ps";  // ps, svg, bin, ppm or png
+  int width = 600;          // Raster size in pixels
+  int height = 600;
+  std::string curve = "koch"; // Koch class, or an L-system preset
+  bool viewport = false;    // Clip the curve to a rectangle
+  bool pipeline = false;    // Writer thread behind a segment ring
+  bool quiet = false;       // No parameter listing on stderr
+  double viewX0 = 0.0, viewY0 = 0.0, viewX1 = 0.0, viewY1 = 0.0;
 
   // --- Argument Parsing and Validation ---
   // This block parses the string arguments into their respective numeric types (double/int)
   // and checks for non-numeric input or extra characters after the number.
-  try {
-    // Use stringstream for robust conversion and error checking
-    std::stringstream ss;
+  // Batch mode has no positional arguments: the curves come from the job file.
+  if (batchPath.empty()) {
+    try {
+      // Use stringstream for robust conversion and error checking
+      std::stringstream ss;
 
-    // Parse coordinates (x1, y1, x2, y2) as doubles
-    ss.str(argv[1]); ss >> x1; if (ss.fail() || !ss.eof()) throw std::runtime_error("x1"); ss.clear();
-    ss.str(argv[2]); ss >> y1; if (ss.fail() || !ss.eof()) throw std::runtime_error("y1"); ss.clear();
-    ss.str(argv[3]); ss >> x2; if (ss.fail() || !ss.eof()) throw std::runtime_error("x2"); ss.clear();
-    ss.str(argv[4]); ss >> y2; if (ss.fail() || !ss.eof()) throw std::runtime_error("y2"); ss.clear();
+      // Parse coordinates (x1, y1, x2, y2) as doubles
+      ss.str(argv[1]); ss >> x1; if (ss.fail() || !ss.eof()) throw std::runtime_error("x1"); ss.clear();
+      ss.str(argv[2]); ss >> y1; if (ss.fail() || !ss.eof()) throw std::runtime_error("y1"); ss.clear();
+      ss.str(argv[3]); ss >> x2; if (ss.fail() || !ss.eof()) throw std::runtime_error("x2"); ss.clear();
+      ss.str(argv[4]); ss >> y2; if (ss.fail() || !ss.eof()) throw std::runtime_error("y2"); ss.clear();
 
-    // Parse level as an integer
-    ss.str(argv[5]); ss >> level; if (ss.fail() || !ss.eof()) throw std::runtime_error("level"); ss.clear();
+      // Parse level as an integer
+      ss.str(argv[5]); ss >> level; if (ss.fail() || !ss.eof()) throw std::runtime_error("level"); ss.clear();
 
+    }
+    catch (const std::runtime_error& e) {
+      // Catch exceptions thrown during stringstream conversion
+      std::cerr << "Error: Invalid numeric input for argument '" << e.what() << "'." << std::endl;
+      return 1;
+    }
   }
-  catch (const std::runtime_error& e) {
-    // Catch exceptions thrown during stringstream conversion
-    std::cerr << "Error: Invalid numeric input for argument '" << e.what() << "'." << std::endl;
-    return 1;
+
+  // --- Option Parsing ---
+  // Options follow the five positional arguments (or --batch) as --name=value.
+  for (int i = batchPath.empty() ? 6 : 2; i < argc; ++i) {
+    std::string option = argv[i];
+    if (option == "--engine=recursive") {
+      engine = Koch::RECURSIVE;
+    }
+    else if (option == "--engine=table") {
+      engine = Koch::DIRECTION_TABLE;
+    }
+    else if (option == "--engine=lattice") {
+      engine = Koch::LATTICE;
+    }
+    else if (option.compare(0, 9, "--output=") == 0 && option.size() > 9) {
+      outputPath = option.substr(9);
+    }
+    else if (option == "--stream") {
+      stream = true;
+    }
+    else if (option == "--compress") {
+      compress = true;
+    }
+    else if (option.compare(0, 10, "--threads=") == 0) {
+      std::stringstream ss(option.substr(10));
+      ss >> threads;
+      if (ss.fail() || !ss.eof() || threads < 1) {
+        std::cerr << "Error: --threads needs a positive integer." << std::endl;
+        return 1;
+      }
+    }
+    else if (option == "--format=ps" || option == "--format=svg" || option == "--format=bin" ||
+      option == "--format=ppm" || option == "--format=png") {
+      format = option.substr(9);
+    }
+    else if (option.compare(0, 7, "--size=") == 0) {
+      // W or WxH
+      std::stringstream ss(option.substr(7));
+      char separator = 'x';
+      ss >> width;
+      height = width;
+      if (!ss.eof()) {
+        ss >> separator >> height;
+      }
+      if (ss.fail() || !ss.eof() || separator != 'x' || width < 1 || height < 1 || width > 32768 || height > 32768) {
+        std::cerr << "Error: --size needs W or WxH with 1 <= W, H <= 32768." << std::endl;
+        return 1;
+      }
+    }
+    else if (option.compare(0, 8, "--curve=") == 0) {
+      curve = option.substr(8);
+      if (curve != "koch" && curve != "snowflake" && curve != "hilbert" && curve != "dragon" &&
+        curve != "sierpinski" && curve != "gosper") {
+        std::cerr << "Error: Unknown curve '" << curve << "'." << std::endl;
+        return 1;
+      }
+    }
+    else if (option == "--pipeline") {
+      pipeline = true;
+    }
+    else if (option == "--quiet") {
+      quiet = true;
+    }
+    else if (option.compare(0, 11, "--viewport=") == 0) {
+      // X0,Y0,X1,Y1
+      std::stringstream ss(option.substr(11));
+      char c1 = ',', c2 = ',', c3 = ',';
+      ss >> viewX0 >> c1 >> viewY0 >> c2 >> viewX1 >> c3 >> viewY1;
+      if (ss.fail() || !ss.eof() || c1 != ',' || c2 != ',' || c3 != ',' || viewX0 > viewX1 || viewY0 > viewY1) {
+        std::cerr << "Error: --viewport needs X0,Y0,X1,Y1 with X0 <= X1 and Y0 <= Y1." << std::endl;
+        return 1;
+      }
+      viewport = true;
+    }
+    else {
+      std::cerr << "Error: Unknown option '" << option << "'." << std::endl;
+      return 1;
+    }
+  }
+
+  // --- Batch Jobs ---
+  // The deepest job is validated below like a single curve.
+  std::vector<KochJob> jobs;
+  if (!batchPath.empty()) {
+    if (curve != "koch") {
+      std::cerr << "Error: --batch is only supported for the koch curve." << std::endl;
+      return 1;
+    }
+    if (batchPath == "-") {
+      if (!readJobs(std::cin, jobs)) {
+        return 1;
+      }
+    }
+    else {
+      std::ifstream in(batchPath);
+      if (!in) {
+        std::cerr << "Error: Cannot open batch file '" << batchPath << "'." << std::endl;
+        return 1;
+      }
+      if (!readJobs(in, jobs)) {
+        return 1;
+      }
+    }
+    if (jobs.empty()) {
+      std::cerr << "Error: The batch has no jobs." << std::endl;
+      return 1;
+    }
+    for (const KochJob& job : jobs) {
+      level = std::max(level, job.level);
+    }
   }
 
   // Validate level
@@ -69,35 +271,168 @@ int main(int argc, char* argv[]) {
 
   // --- Max Level Validation ---
   // Define a practical maximum level to prevent excessive computation and output size.
+  // Streaming mode generates in constant memory, so only output size limits it;
+  // MAX_STREAM_LEVEL keeps the segment count well inside 64 bits.
   const int MAX_LEVEL = 10;
+  const int MAX_STREAM_LEVEL = 20;
 
   // Validate max level
-  if (level > MAX_LEVEL) {
-    // Use long long for the power calculation to prevent overflow for large levels
-    std::cerr << "Error: Curve level exceeds the maximum practical limit of " << MAX_LEVEL << "." << std::endl;
-    std::cerr << "A level of " << level << " would generate over " << (long long)pow(4, level) << " line segments." << std::endl;
+  // Koch rasters stop at pixel detail, so their cost does not grow past the image size.
+  // A viewport generates only the visible part, so its cost follows the tile's contents.
+  // L-systems grow at different rates, so they are also held to the segment
+  // count of a Koch curve at the level limit.
+  const bool raster = format == "ppm" || format == "png";
+  const bool isKoch = curve == "koch";
+  std::unique_ptr<LSystem> lsystem;
+  if (!isKoch) {
+    lsystem.reset(new LSystem(LSystem::preset(curve)));
+  }
+  if (viewport && !isKoch) {
+    std::cerr << "Error: --viewport is only supported for the koch curve." << std::endl;
+    return 1;
+  }
+  const int levelLimit = (stream || (isKoch && (raster || viewport))) ? MAX_STREAM_LEVEL : MAX_LEVEL;
+  const std::uint64_t segmentLimit = std::uint64_t(1) << (2 * levelLimit);
+  std::uint64_t segments = 0;
+  if (level < 32) {
+    segments = isKoch ? (std::uint64_t(1) << (2 * level)) : lsystem->segmentCount(level);
+  }
+  if (level > levelLimit || segments > segmentLimit) {
+    std::cerr << "Error: Curve level exceeds the maximum practical limit of " << levelLimit
+      << " (" << segmentLimit << " segments)." << std::endl;
+    if (level < 32) {
+      std::cerr << "A level of " << level << " would generate " << segments << " line segments." << std::endl;
+    }
+    if (!stream) {
+      std::cerr << "Use --stream for levels up to " << MAX_STREAM_LEVEL << "." << std::endl;
+    }
     return 1;
   }
 
+  // Batch total for display
+  if (!jobs.empty()) {
+    segments = 0;
+    for (const KochJob& job : jobs) {
+      segments += std::uint64_t(1) << (2 * job.level);
+    }
+  }
+
+  // Clipping always uses the table engine. Streaming, multi-threaded and batch
+  // generation replace the recursion with it (the lattice engine streams too,
+  // on one thread).
+  if (viewport || (engine == Koch::RECURSIVE && (stream || threads > 1 || !jobs.empty()))) {
+    engine = Koch::DIRECTION_TABLE;
+  }
+
+  // The pipeline replaces the worker pool's own in-order joining
+  if (pipeline && threads > 1) {
+    std::cerr << "Error: --pipeline cannot be combined with --threads." << std::endl;
+    return 1;
+  }
+
+#ifndef KOCH_WITH_ZLIB
+  if (compress) {
+    std::cerr << "Error: --compress requires a build with -DKOCH_WITH_ZLIB -lz." << std::endl;
+    return 1;
+  }
+#endif
+
   // --- Display Parsed Parameters ---
-  std::cerr << "Parameters entered:" << std::endl;
-  std::cerr << "  x1 = " << x1 << std::endl;
-  std::cerr << "  y1 = " << y1 << std::endl;
-  std::cerr << "  x2 = " << x2 << std::endl;
-  std::cerr << "  y2 = " << y2 << std::endl;
-  std::cerr << "  level = " << level << std::endl;
-  std::cerr << std::endl; // Blank line before PostScript output
+  // Skipped with --quiet, e.g. when the generator is timed
+  if (!quiet) {
+    std::cerr << "Parameters entered:" << std::endl;
+    if (jobs.empty()) {
+      std::cerr << "  x1 = " << x1 << std::endl;
+      std::cerr << "  y1 = " << y1 << std::endl;
+      std::cerr << "  x2 = " << x2 << std::endl;
+      std::cerr << "  y2 = " << y2 << std::endl;
+      std::cerr << "  level = " << level << std::endl;
+    }
+    else {
+      std::cerr << "  batch = " << (batchPath == "-" ? "stdin" : batchPath) << " (" << jobs.size()
+        << " curves, deepest level " << level << ")" << std::endl;
+    }
+    std::cerr << "  engine = " << (engine == Koch::DIRECTION_TABLE ? "table" : engine == Koch::LATTICE ? "lattice" : "recursive") << std::endl;
+    std::cerr << "  output = " << (outputPath.empty() ? "stdout" : outputPath) << (compress ? " (gzip)" : "") << std::endl;
+    std::cerr << "  threads = " << threads << (pipeline ? " + writer thread" : "") << std::endl;
+    std::cerr << "  format = " << format;
+    if (raster) {
+      std::cerr << " (" << width << "x" << height << ")";
+    }
+    std::cerr << std::endl;
+    std::cerr << "  curve = " << curve << std::endl;
+    if (viewport) {
+      std::cerr << "  viewport = " << viewX0 << "," << viewY0 << " to " << viewX1 << "," << viewY1 << std::endl;
+    }
+    std::cerr << "  segments = " << segments << (viewport ? " (before clipping)" : "") << std::endl;
+    std::cerr << std::endl; // Blank line before PostScript output
+  }
 
 
   // --- Object Instantiation and Orchestration ---
 
   // 1. Create the Koch object.
   Koch koch;
+  koch.setEngine(engine);
+  koch.setThreads(threads);
+  if (viewport) {
+    koch.setViewport(viewX0, viewY0, viewX1, viewY1);
+  }
 
   // 2. Generate the Koch curve.
   // The Koch object handles the internal Turtle initialization, recursion, and final Postscript output.
-  // The output is sent to sdout, which can be redirecte to a file (e.g., ./koch ... > output.ps).
-  koch.generateCurve(level, x1, y1, x2, y2);
+  // The output is sent to sdout, which can be redirecte to a file (e.g., ./koch ... > output.ps),
+  // or written directly to the --output file, optionally gzip-compressed on the way.
+  try {
+    std::unique_ptr<FileOutput> file(outputPath.empty() ? new FileOutput(1) : new FileOutput(outputPath));
+    ByteOutput* text = file.get();
+#ifdef KOCH_WITH_ZLIB
+    std::unique_ptr<GzipOutput> gzip;
+    if (compress) {
+      gzip.reset(new GzipOutput(*file, 1));  // Fastest level: keep up with generation
+      text = gzip.get();
+    }
+#endif
+    std::unique_ptr<PathSink> sink;
+    if (raster) {
+      RasterSink* image = new RasterSink(*text, width, height, format == "png" ? RasterSink::PNG : RasterSink::PPM);
+      sink.reset(image);
+      koch.setDetail(image->pixelSize());
+    }
+    else if (format == "svg") {
+      sink.reset(new SvgWriter(*text));
+    }
+    else if (format == "bin") {
+      sink.reset(new BinaryPathWriter(*text));
+    }
+    else {
+      sink.reset(new PostScriptWriter(*text));
+    }
+    // Optionally run the sink on a writer thread behind a segment ring
+    std::unique_ptr<PipelineSink> pipe;
+    PathSink* target = sink.get();
+    if (pipeline) {
+      pipe.reset(new PipelineSink(*sink));
+      target = pipe.get();
+    }
+    if (lsystem) {
+      lsystem->generate(level, x1, y1, x2, y2, *target);
+    }
+    else if (!jobs.empty()) {
+      koch.setOutput(target);
+      koch.generateBatch(jobs);
+    }
+    else {
+      koch.setOutput(target);
+      koch.generateCurve(level, x1, y1, x2, y2);
+    }
+    text->close();
+    file->close();
+  }
+  catch (const std::runtime_error& e) {
+    std::cerr << "Error: " << e.what() << std::endl;
+    return 1;
+  }
 
   return 0; // Exit with success code
 }
\ No newline at end of file
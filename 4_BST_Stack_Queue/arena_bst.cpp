@@ -0,0 +1,232 @@
+#ifndef ARENA_BST_CPP
+#define ARENA_BST_CPP
+
+#include "arena_bst.h"
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+
+// Private helper to take a slot and construct a leaf node in it
+// Reuses the most recently freed slot, else the next unused one,
+// adding a chunk when the last one is full
+template <typename Object>
+uint32_t ArenaBST<Object>::allocate(const Object& value) {
+  uint32_t index = freeList;
+  bool fresh = (index == NIL);
+  if (fresh) {
+    if (used == NIL) {
+      throw length_error("ArenaBST is limited to 2^32 - 1 nodes");
+    }
+    if ((used >> CHUNK_BITS) == chunks.size()) {
+      chunks.push_back(static_cast<ArenaNode<Object>*>(
+        ::operator new(CHUNK_SIZE * sizeof(ArenaNode<Object>))));
+    }
+    index = used;
+  }
+
+  ArenaNode<Object>& slot = node(index);
+  uint32_t nextFree = fresh ? NIL : slot.left;
+  new (&slot.data) Object(value);   // May throw: the slot is claimed only after
+  slot.left = NIL;
+  slot.right = NIL;
+  if (fresh) {
+    ++used;
+  }
+  else {
+    freeList = nextFree;
+  }
+  return index;
+}
+
+// Private helper to destroy a node's value and push its slot on the free list
+template <typename Object>
+void ArenaBST<Object>::release(uint32_t index) {
+  ArenaNode<Object>& slot = node(index);
+  slot.data.~Object();
+  slot.left = freeList;
+  freeList = index;
+}
+
+// Private helper to destroy every value before the chunks are freed
+// Rotates each left child up until the current node has none, then moves
+// on to its right child: one pass, no stack
+template <typename Object>
+void ArenaBST<Object>::destroyAll() {
+  uint32_t current = root;
+  while (current != NIL) {
+    ArenaNode<Object>& n = node(current);
+    if (n.left != NIL) {
+      uint32_t child = n.left;
+      n.left = node(child).right;
+      node(child).right = current;
+      current = child;
+    }
+    else {
+      uint32_t next = n.right;
+      n.data.~Object();
+      current = next;
+    }
+  }
+}
+
+// Constructor: initializes an empty tree with no chunks
+template <typename Object>
+ArenaBST<Object>::ArenaBST() : root(NIL), used(0), freeList(NIL), count(0) {}
+
+// Destructor: frees the arena
+template <typename Object>
+ArenaBST<Object>::~ArenaBST() {
+  clear();
+}
+
+// Public method to remove every value
+// Values that need no destructor are dropped with their chunks
+template <typename Object>
+void ArenaBST<Object>::clear() {
+  if (!is_trivially_destructible<Object>::value) {
+    destroyAll();
+  }
+  for (ArenaNode<Object>* chunk : chunks) {
+    ::operator delete(chunk);
+  }
+  chunks.clear();
+  root = NIL;
+  used = 0;
+  freeList = NIL;
+  count = 0;
+}
+
+// Public method to insert a value into the tree
+// Descends through the child indices to the empty one where the value belongs
+template <typename Object>
+void ArenaBST<Object>::insert(const Object& value) {
+  uint32_t* link = &root;
+  while (*link != NIL) {
+    ArenaNode<Object>& n = node(*link);
+    if (value < n.data) {
+      link = &n.left;
+    }
+    else if (value > n.data) {
+      link = &n.right;
+    }
+    else {
+      // If value equals node data, do nothing (ignore duplicates)
+      return;
+    }
+  }
+  // Chunks never move, so link stays valid while a chunk is added
+  *link = allocate(value);
+  ++count;
+}
+
+// Public method to remove a value from the tree
+// A node with two children takes the smallest node of its right subtree
+// in its place. Returns true if the value was found.
+template <typename Object>
+bool ArenaBST<Object>::remove(const Object& value) {
+  uint32_t* link = &root;
+  while (*link != NIL && (value < node(*link).data || value > node(*link).data)) {
+    ArenaNode<Object>& n = node(*link);
+    link = (value < n.data) ? &n.left : &n.right;
+  }
+  if (*link == NIL) {
+    return false;
+  }
+
+  uint32_t doomed = *link;
+  ArenaNode<Object>& n = node(doomed);
+  if (n.left == NIL) {
+    *link = n.right;
+  }
+  else if (n.right == NIL) {
+    *link = n.left;
+  }
+  else {
+    uint32_t* successorLink = &n.right;
+    while (node(*successorLink).left != NIL) {
+      successorLink = &node(*successorLink).left;
+    }
+    uint32_t successor = *successorLink;
+    *successorLink = node(successor).right;
+    node(successor).left = n.left;
+    node(successor).right = n.right;
+    *link = successor;
+  }
+  release(doomed);
+  --count;
+  return true;
+}
+
+// Public method to check if a value exists in the tree
+template <typename Object>
+bool ArenaBST<Object>::retrieve(const Object& value) const {
+  uint32_t current = root;
+  while (current != NIL) {
+    const ArenaNode<Object>& n = node(current);
+    if (value < n.data) {
+      current = n.left;
+    }
+    else if (value > n.data) {
+      current = n.right;
+    }
+    else {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Number of levels in the tree, counted one level at a time
+template <typename Object>
+int ArenaBST<Object>::height() const {
+  int levels = 0;
+  queue<uint32_t> level;
+  if (root != NIL) {
+    level.push(root);
+  }
+  while (!level.empty()) {
+    ++levels;
+    for (size_t remaining = level.size(); remaining > 0; --remaining) {
+      const ArenaNode<Object>& n = node(level.front());
+      level.pop();
+      if (n.left != NIL) {
+        level.push(n.left);
+      }
+      if (n.right != NIL) {
+        level.push(n.right);
+      }
+    }
+  }
+  return levels;
+}
+
+// Bytes of node storage plus the chunk table
+template <typename Object>
+size_t ArenaBST<Object>::memoryUsage() const {
+  return chunks.size() * CHUNK_SIZE * sizeof(ArenaNode<Object>) +
+    chunks.capacity() * sizeof(ArenaNode<Object>*);
+}
+
+// In-order traversal with an explicit stack of indices
+template <typename Object>
+template <typename Visitor>
+bool ArenaBST<Object>::visitInOrder(Visitor visit) const {
+  vector<uint32_t> stack;
+  uint32_t current = root;
+  while (current != NIL || !stack.empty()) {
+    // Traverse to the leftmost node of current subtree
+    while (current != NIL) {
+      stack.push_back(current);
+      current = node(current).left;
+    }
+    const ArenaNode<Object>& n = node(stack.back());
+    stack.pop_back();
+    if (!visit(n.data)) {
+      return false;
+    }
+    current = n.right;
+  }
+  return true;
+}
+
+#endif
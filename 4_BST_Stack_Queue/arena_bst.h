@@ -0,0 +1,81 @@
+#ifndef ARENA_BST_H
+#define ARENA_BST_H
+
+#include <cstddef>
+#include <cstdint>
+#include <queue>
+#include <vector>
+using namespace std;
+
+// Node structure for the arena-backed Binary Search Tree
+// Children are 32-bit indices into the tree's arena instead of pointers,
+// so a node costs its data plus 8 bytes (12 bytes for an int key, against
+// 24 bytes and a heap allocation for Node<int>)
+template <typename Object>
+struct ArenaNode {
+  Object data;           // The data stored in this node
+  uint32_t left;         // Index of left child node (NIL if none); next free slot while free
+  uint32_t right;        // Index of right child node (NIL if none)
+};
+
+// Arena-backed Binary Search Tree class template
+// Same search tree rules as BST<Object> (unbalanced, duplicates ignored),
+// but nodes live in fixed-size chunks owned by the tree and are addressed
+// by 32-bit index: slot i is entry i % CHUNK_SIZE of chunk i / CHUNK_SIZE.
+// Chunks never move, so up to 2^32 - 1 nodes are stored without reallocating.
+// Removed slots go on an internal free list and are reused first. clear()
+// frees whole chunks: O(chunks) when Object needs no destructor, otherwise
+// each value is destroyed on one walk of the tree.
+template <typename Object>
+class ArenaBST {
+private:
+  static const uint32_t NIL = 0xFFFFFFFFu;      // "No node" index
+  static const int CHUNK_BITS = 12;             // 4096 nodes per chunk
+  static const uint32_t CHUNK_SIZE = 1u << CHUNK_BITS;
+
+  vector<ArenaNode<Object>*> chunks;  // Raw node storage; slots are constructed when in use
+  uint32_t root;                      // Index of the root (NIL if empty)
+  uint32_t used;                      // Slots handed out so far (bump allocator)
+  uint32_t freeList;                  // First free slot (NIL if none)
+  size_t count;                       // Number of values in the tree
+
+  // Prevent copying of the tree (the arena is owned)
+  ArenaBST(const ArenaBST&) = delete;
+  ArenaBST& operator=(const ArenaBST&) = delete;
+
+  // Node at an index
+  ArenaNode<Object>& node(uint32_t index) {
+    return chunks[index >> CHUNK_BITS][index & (CHUNK_SIZE - 1)];
+  }
+  const ArenaNode<Object>& node(uint32_t index) const {
+    return chunks[index >> CHUNK_BITS][index & (CHUNK_SIZE - 1)];
+  }
+
+  // Private helper methods
+  uint32_t allocate(const Object& value);   // Free slot with a new leaf node
+  void release(uint32_t index);             // Destroys the node, frees its slot
+  void destroyAll();                        // Destroys every value in the tree
+
+public:
+  ArenaBST();     // Constructor
+  ~ArenaBST();    // Destructor
+
+  // Public interface methods
+  void insert(const Object& value);           // Insert value into the tree
+  bool remove(const Object& value);           // Remove value; false if not found
+  bool retrieve(const Object& value) const;   // Check if value exists
+  void clear();                               // Remove every value, free the arena
+  size_t size() const { return count; }       // Number of values
+  int height() const;                         // Number of levels (0 if empty)
+  size_t memoryUsage() const;                 // Bytes held by the arena
+
+  // Calls visit(const Object&) for every value in ascending order; visit
+  // returns false to stop early. Returns false if stopped.
+  template <typename Visitor>
+  bool visitInOrder(Visitor visit) const;
+};
+
+// Include the implementation for template class
+#include "arena_bst.cpp"
+
+#endif
@@ -0,0 +1,182 @@
+// benchmark.cpp
+// Scott Elliott
+
+// Lookup microbenchmark for the BST template class.
+// Measures retrieve() on four trees built from the even keys 0, 2, ...:
+//   avl       BST<int, AvlBalance>, keys inserted in ascending order
+//   frozen    the avl tree's FrozenBST snapshot (Eytzinger array)
+//   random    BST<int>, keys inserted in random order
+//   arena     ArenaBST<int>, the same random order (so the same shape)
+//   skewed    BST<int>, keys inserted in ascending order (a linked list;
+//             its build is quadratic, so it stops at 2^13 keys)
+// Hits probe random present keys, misses probe random odd keys. Each result
+// is one JSON object with ns per lookup and ns per level, where levels is
+// the average number of nodes a hit visits (the average depth, computed as
+// the sum of all subtree sizes over n; a frozen search always visits every
+// level).
+// Sizes sweep from 2^10 to 2^maxExponent.
+//
+// Compilation: g++ -std=c++11 -O2 benchmark.cpp -o bst_benchmark
+// Execution:   ./bst_benchmark [maxExponent] > results.json
+//              (default: 20)
+
+#include "bst.h"
+#include "arena_bst.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double since(Clock::time_point start) {
+  return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// Lookups timed per measurement
+const std::size_t PROBES = 1 << 20;
+
+// Largest skewed tree (n^2 / 2 steps to build)
+const int MAX_SKEWED_EXPONENT = 13;
+
+// Sink for lookup results so the loops are not optimized out
+std::size_t checksum = 0;
+
+template <typename Tree>
+double timeLookups(const Tree& tree, const std::vector<int>& probes) {
+  std::size_t found = 0;
+  Clock::time_point start = Clock::now();
+  for (int key : probes) {
+    found += tree.retrieve(key) ? 1 : 0;
+  }
+  double s = since(start);
+  checksum += found;
+  return s * 1e9 / probes.size();
+}
+
+// Average depth of a node (root = 1): every node is counted once for each
+// of its ancestors, i.e. the sum of all subtree sizes divided by n
+template <typename Tree>
+double averageLevels(const Tree& tree, const std::vector<int>& keys) {
+  double total = 0;
+  for (int key : keys) {
+    total += static_cast<double>(tree.pre_order_traversal(key).size());
+  }
+  return total / keys.size();
+}
+
+bool firstRecord = true;
+
+void report(const std::string& name, int n, int height, double levels, double hitNs, double missNs) {
+  std::cout << (firstRecord ? "  " : ",\n  ")
+    << "{\"tree\": \"" << name << "\", \"n\": " << n
+    << ", \"height\": " << height << ", \"average_levels\": " << levels
+    << ", \"hit_ns\": " << hitNs << ", \"miss_ns\": " << missNs
+    << ", \"ns_per_level\": " << hitNs / levels << "}";
+  firstRecord = false;
+}
+
+// Random present (even) and absent (odd) keys of a tree of n keys
+void makeProbes(int n, std::mt19937& gen, std::vector<int>& hits, std::vector<int>& misses) {
+  std::uniform_int_distribution<int> pick(0, n - 1);
+  hits.resize(PROBES);
+  misses.resize(PROBES);
+  for (std::size_t i = 0; i < PROBES; ++i) {
+    hits[i] = 2 * pick(gen);
+    misses[i] = 2 * pick(gen) + 1;
+  }
+}
+
+// Returns the tree's average levels
+template <typename Tree>
+double bench(const std::string& name, const std::vector<int>& order, std::mt19937& gen) {
+  Tree tree;
+  for (int key : order) {
+    tree.insert(key);
+  }
+
+  const int n = static_cast<int>(order.size());
+  std::vector<int> hits, misses;
+  makeProbes(n, gen, hits, misses);
+  double hitNs = timeLookups(tree, hits);
+  double missNs = timeLookups(tree, misses);
+  double levels = averageLevels(tree, order);
+  report(name, n, tree.height(), levels, hitNs, missNs);
+  return levels;
+}
+
+// Arena tree with the shape of a BST<int> built from the same order, whose
+// average levels are given (the arena tree has no traversal queues)
+void benchArena(const std::vector<int>& order, double levels, std::mt19937& gen) {
+  ArenaBST<int> tree;
+  for (int key : order) {
+    tree.insert(key);
+  }
+
+  const int n = static_cast<int>(order.size());
+  std::vector<int> hits, misses;
+  makeProbes(n, gen, hits, misses);
+  double hitNs = timeLookups(tree, hits);
+  double missNs = timeLookups(tree, misses);
+  report("arena", n, tree.height(), levels, hitNs, missNs);
+}
+
+// Snapshot of an AVL tree; every search descends through all levels
+void benchFrozen(const std::vector<int>& ascending, std::mt19937& gen) {
+  BST<int, AvlBalance> tree;
+  for (int key : ascending) {
+    tree.insert(key);
+  }
+  FrozenBST<int> frozen = tree.freeze();
+
+  const int n = static_cast<int>(ascending.size());
+  int levels = 0;
+  for (std::size_t k = 1; k <= frozen.size(); k *= 2) {
+    ++levels;
+  }
+  std::vector<int> hits, misses;
+  makeProbes(n, gen, hits, misses);
+  double hitNs = timeLookups(frozen, hits);
+  double missNs = timeLookups(frozen, misses);
+  report("frozen", n, levels, levels, hitNs, missNs);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+  int maxExponent = 20;
+  if (argc > 1) maxExponent = std::atoi(argv[1]);
+  if (maxExponent < 10 || maxExponent > 26) {
+    std::cerr << "Usage: " << argv[0] << " [maxExponent 10-26]" << std::endl;
+    return 1;
+  }
+
+  std::mt19937 gen(42);
+  std::cout << "[\n";
+  for (int e = 10; e <= maxExponent; ++e) {
+    std::cerr << "n = 2^" << e << std::endl;
+    std::vector<int> ascending(std::size_t(1) << e);
+    for (std::size_t i = 0; i < ascending.size(); ++i) {
+      ascending[i] = 2 * static_cast<int>(i);
+    }
+    std::vector<int> shuffled = ascending;
+    std::shuffle(shuffled.begin(), shuffled.end(), gen);
+
+    bench<BST<int, AvlBalance> >("avl", ascending, gen);
+    benchFrozen(ascending, gen);
+    double randomLevels = bench<BST<int> >("random", shuffled, gen);
+    benchArena(shuffled, randomLevels, gen);
+    if (e <= MAX_SKEWED_EXPONENT) {
+      bench<BST<int> >("skewed", ascending, gen);
+    }
+  }
+  std::cout << "\n]" << std::endl;
+
+  std::cerr << "checksum " << checksum << std::endl;
+  return 0;
+}
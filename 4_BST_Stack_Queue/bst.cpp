@@ -3,105 +3,508 @@
 
 #include "bst.h"
 
-// Private recursive helper to insert a value into the BST
-// Uses reference to pointer to modify parent's child pointer
+// Prefetch hint for FrozenBST searches; a no-op without a compiler builtin
+#if defined(__GNUC__)
+#define BST_PREFETCH(address) __builtin_prefetch(address)
+#else
+#define BST_PREFETCH(address) ((void)(address))
+#endif
+
+// Copy constructor: copies the inline entries in use and the overflow
+// (the rest of the inline array is never read, so it is left unset)
 template <typename Object>
-void BST<Object>::insert(Node<Object>*& node, const Object& value) {
-  if (node == nullptr) {
-    // Base case: create new node when we reach insertion point
-    node = new Node<Object>(value);
+NodeStack<Object>::NodeStack(const NodeStack& other) : overflow(other.overflow), count(other.count) {
+  copy(other.fixed, other.fixed + (count < INLINE ? count : INLINE), fixed);
+}
+
+// Copy assignment: as the copy constructor
+template <typename Object>
+NodeStack<Object>& NodeStack<Object>::operator=(const NodeStack& other) {
+  if (this != &other) {
+    copy(other.fixed, other.fixed + (other.count < INLINE ? other.count : INLINE), fixed);
+    overflow = other.overflow;
+    count = other.count;
   }
-  else if (value < node->data) {
-    // Recursive case: value is less than current node, go left
-    insert(node->left, value);
+  return *this;
+}
+
+// Pushes a node, spilling past the inline entries
+template <typename Object>
+void NodeStack<Object>::push(const Node<Object>* node) {
+  if (count < INLINE) {
+    fixed[count] = node;
   }
-  else if (value > node->data) {
-    // Recursive case: value is greater than current node, go right
-    insert(node->right, value);
+  else {
+    overflow.push_back(node);
   }
-  // If value equals node data, do nothing (ignore duplicates)
+  ++count;
 }
 
-// Private recursive helper to search for a value in the BST
-// Returns true if value found, false otherwise
+// Most recently pushed node; the stack must not be empty
 template <typename Object>
-bool BST<Object>::retrieve(Node<Object>* node, const Object& value) const {
-  if (node == nullptr) {
-    // Base case: value not found
-    return false;
+const Node<Object>* NodeStack<Object>::top() const {
+  return count <= INLINE ? fixed[count - 1] : overflow.back();
+}
+
+// Removes the most recently pushed node
+template <typename Object>
+void NodeStack<Object>::pop() {
+  --count;
+  if (count >= INLINE) {
+    overflow.pop_back();
   }
-  else if (value < node->data) {
-    // Recursive case: search left subtree
-    return retrieve(node->left, value);
+}
+
+// Constructor: positions the iterator on the first node of start's subtree
+// A null start gives the end iterator
+template <typename Object>
+TreeIterator<Object>::TreeIterator(const Node<Object>* start, TraversalOrder walk)
+  : order(walk), current(nullptr) {
+  if (start == nullptr) {
+    return;
   }
-  else if (value > node->data) {
-    // Recursive case: search right subtree
-    return retrieve(node->right, value);
+  if (order == PRE_ORDER) {
+    current = start;
   }
   else {
-    // Base case: value found
-    return true;
+    descend(start);
+    current = stack.top();
   }
 }
 
-// Private recursive helper to find a specific node by value
-// Returns pointer to node if found, nullptr otherwise
+// In-order: follow left children. Post-order: follow left children, or the
+// right child where there is no left one, down to a leaf.
 template <typename Object>
-Node<Object>* BST<Object>::findNode(Node<Object>* node,
-  const Object& value) const {
-  if (node == nullptr) {
-    return nullptr;
+void TreeIterator<Object>::descend(const Node<Object>* node) {
+  while (node != nullptr) {
+    stack.push(node);
+    if (node->left != nullptr) {
+      node = node->left;
+    }
+    else {
+      node = (order == POST_ORDER) ? node->right : nullptr;
+    }
   }
-  else if (value < node->data) {
-    return findNode(node->left, value);
+}
+
+// Advances to the next node in the traversal order
+template <typename Object>
+TreeIterator<Object>& TreeIterator<Object>::operator++() {
+  if (order == PRE_ORDER) {
+    // Left child next; the right child waits on the stack
+    if (current->right != nullptr) {
+      stack.push(current->right);
+    }
+    if (current->left != nullptr) {
+      current = current->left;
+    }
+    else if (!stack.empty()) {
+      current = stack.top();
+      stack.pop();
+    }
+    else {
+      current = nullptr;
+    }
   }
-  else if (value > node->data) {
-    return findNode(node->right, value);
+  else if (order == IN_ORDER) {
+    // The current node is on top: replace it by the leftmost path of its
+    // right subtree; otherwise its parent chain continues
+    stack.pop();
+    descend(current->right);
+    current = stack.empty() ? nullptr : stack.top();
   }
   else {
-    return node;
+    // The current node is done; its parent comes next unless the current
+    // node is a left child with a right sibling to walk first
+    stack.pop();
+    if (stack.empty()) {
+      current = nullptr;
+    }
+    else {
+      const Node<Object>* parent = stack.top();
+      if (parent->left == current && parent->right != nullptr) {
+        descend(parent->right);
+      }
+      current = stack.top();
+    }
   }
+  return *this;
+}
+
+// Post-increment
+template <typename Object>
+TreeIterator<Object> TreeIterator<Object>::operator++(int) {
+  TreeIterator previous = *this;
+  ++*this;
+  return previous;
+}
+
+// AVL policy: height of a possibly empty subtree
+// (every node of an AVL tree is allocated as an AvlNode)
+template <typename Object>
+int AvlBalance::height(const Node<Object>* node) {
+  return node == nullptr ? 0 : static_cast<const AvlNode<Object>*>(node)->height;
+}
+
+// AVL policy: records the height of a node built by buildFrom
+template <typename Object>
+void AvlBalance::setHeight(Node<Object>* node, int height) {
+  static_cast<AvlNode<Object>*>(node)->height = height;
+}
+
+// AVL policy: recomputes a node's height from its children
+template <typename Object>
+void AvlBalance::update(Node<Object>* node) {
+  int leftHeight = height(node->left);
+  int rightHeight = height(node->right);
+  setHeight(node, 1 + (leftHeight > rightHeight ? leftHeight : rightHeight));
+}
+
+// AVL policy: the right child becomes the root of this subtree
+template <typename Object>
+void AvlBalance::rotateLeft(Node<Object>*& node) {
+  Node<Object>* pivot = node->right;
+  node->right = pivot->left;
+  pivot->left = node;
+  update(node);
+  update(pivot);
+  node = pivot;
+}
+
+// AVL policy: the left child becomes the root of this subtree
+template <typename Object>
+void AvlBalance::rotateRight(Node<Object>*& node) {
+  Node<Object>* pivot = node->left;
+  node->left = pivot->right;
+  pivot->right = node;
+  update(node);
+  update(pivot);
+  node = pivot;
 }
 
-// Private recursive helper to deallocate all nodes in the BST
-// Uses post-order traversal to safely delete nodes
+// AVL policy: restores the balance of a node whose subtrees are balanced
+// but may differ in height by two. A child leaning the other way is rotated
+// first (the double rotation cases).
 template <typename Object>
-void BST<Object>::clear(Node<Object>* node) {
-  if (node != nullptr) {
-    clear(node->left);   // Delete left subtree first
-    clear(node->right);  // Delete right subtree next
-    delete node;         // Delete current node last
+void AvlBalance::rebalance(Node<Object>*& node) {
+  if (node == nullptr) {
+    return;
+  }
+  int balance = height(node->left) - height(node->right);
+  if (balance > 1) {
+    if (height(node->left->left) < height(node->left->right)) {
+      rotateLeft(node->left);
+    }
+    rotateRight(node);
+  }
+  else if (balance < -1) {
+    if (height(node->right->right) < height(node->right->left)) {
+      rotateRight(node->right);
+    }
+    rotateLeft(node);
+  }
+  else {
+    update(node);
+  }
+}
+
+// Private helper to rebalance the recorded path, deepest link first
+// Each entry is the link (root or a child pointer) that holds a path node
+template <typename Object, typename Balance>
+void BST<Object, Balance>::rebalancePath(Node<Object>** path[], int length) {
+  while (length > 0) {
+    Balance::rebalance(*path[--length]);
+  }
+}
+
+// Private iterative helper to find a specific node by value
+// Returns pointer to node if found, nullptr otherwise
+template <typename Object, typename Balance>
+Node<Object>* BST<Object, Balance>::findNode(Node<Object>* node,
+  const Object& value) const {
+  while (node != nullptr) {
+    if (value < node->data) {
+      node = node->left;
+    }
+    else if (value > node->data) {
+      node = node->right;
+    }
+    else {
+      return node;
+    }
+  }
+  return nullptr;
+}
+
+// Private iterative helper to deallocate all nodes in the BST
+// Rotates each left child up until the current node has none, then deletes
+// it and continues with its right child: no stack, whatever the tree shape
+template <typename Object, typename Balance>
+void BST<Object, Balance>::clear(Node<Object>* node) {
+  while (node != nullptr) {
+    if (node->left != nullptr) {
+      Node<Object>* child = node->left;
+      node->left = child->right;
+      child->right = node;
+      node = child;
+    }
+    else {
+      Node<Object>* next = node->right;
+      destroyNode(node);
+      node = next;
+    }
   }
 }
 
+// Private helper to free one node: heap nodes are deleted, block nodes are
+// only destroyed (their memory goes with the block). A node is in the block
+// if its address is inside the block's range.
+template <typename Object, typename Balance>
+void BST<Object, Balance>::destroyNode(Node<Object>* node) {
+  TreeNode* treeNode = static_cast<TreeNode*>(node);
+  less<const TreeNode*> before;
+  if (block != nullptr && !before(treeNode, block) && before(treeNode, blockEnd)) {
+    treeNode->~TreeNode();
+  }
+  else {
+    delete treeNode;
+  }
+}
+
+// Private helper to free the buildFrom block (its nodes already destroyed)
+template <typename Object, typename Balance>
+void BST<Object, Balance>::releaseBlock() {
+  ::operator delete(block);
+  block = nullptr;
+  blockEnd = nullptr;
+}
+
 // Constructor: initializes empty BST with null root
-template <typename Object>
-BST<Object>::BST() : root(nullptr) {}
+template <typename Object, typename Balance>
+BST<Object, Balance>::BST() : root(nullptr), block(nullptr), blockEnd(nullptr) {}
 
 // Destructor: cleans up all dynamically allocated nodes
-template <typename Object>
-BST<Object>::~BST() {
+template <typename Object, typename Balance>
+BST<Object, Balance>::~BST() {
   clear(root);
+  releaseBlock();
 }
 
 // Public method to insert a value into the BST
-// Calls private recursive helper starting from root
-template <typename Object>
-void BST<Object>::insert(const Object& value) {
-  insert(root, value);
+// Descends through the child links (pointer to pointer) to the empty link
+// where the value belongs; with a balancing policy, the links on the way
+// down are recorded and rebalanced afterwards
+template <typename Object, typename Balance>
+void BST<Object, Balance>::insert(const Object& value) {
+  Node<Object>** path[Balance::PATH_LENGTH + 1];
+  int length = 0;
+  Node<Object>** link = &root;
+  while (*link != nullptr) {
+    if (Balance::PATH_LENGTH > 0) {
+      path[length++] = link;
+    }
+    if (value < (*link)->data) {
+      link = &(*link)->left;
+    }
+    else if (value > (*link)->data) {
+      link = &(*link)->right;
+    }
+    else {
+      // If value equals node data, do nothing (ignore duplicates)
+      return;
+    }
+  }
+  *link = new TreeNode(value);
+  rebalancePath(path, length);
+}
+
+// Public method to remove a value from the BST
+// A node with two children takes the smallest node of its right subtree
+// in its place (relinked, not copied). Returns true if the value was found.
+template <typename Object, typename Balance>
+bool BST<Object, Balance>::remove(const Object& value) {
+  Node<Object>** path[Balance::PATH_LENGTH + 1];
+  int length = 0;
+  Node<Object>** link = &root;
+  while (*link != nullptr && (value < (*link)->data || value > (*link)->data)) {
+    if (Balance::PATH_LENGTH > 0) {
+      path[length++] = link;
+    }
+    link = (value < (*link)->data) ? &(*link)->left : &(*link)->right;
+  }
+  if (*link == nullptr) {
+    return false;
+  }
+
+  Node<Object>* doomed = *link;
+  if (Balance::PATH_LENGTH > 0) {
+    path[length++] = link;
+  }
+  if (doomed->left == nullptr) {
+    *link = doomed->right;
+  }
+  else if (doomed->right == nullptr) {
+    *link = doomed->left;
+  }
+  else {
+    // Find the successor, recording the links down to it
+    int first = length;
+    Node<Object>** successorLink = &doomed->right;
+    while ((*successorLink)->left != nullptr) {
+      if (Balance::PATH_LENGTH > 0) {
+        path[length++] = successorLink;
+      }
+      successorLink = &(*successorLink)->left;
+    }
+    Node<Object>* successor = *successorLink;
+    *successorLink = successor->right;
+    successor->left = doomed->left;
+    successor->right = doomed->right;
+    *link = successor;
+    // The first recorded link belonged to the removed node
+    if (Balance::PATH_LENGTH > 0 && length > first) {
+      path[first] = &successor->right;
+    }
+  }
+  destroyNode(doomed);
+  rebalancePath(path, length);
+  return true;
 }
 
 // Public method to check if a value exists in the BST
-// Calls private recursive helper starting from root
-template <typename Object>
-bool BST<Object>::retrieve(const Object& value) const {
-  return retrieve(root, value);
+// A plain loop from the root: no call per level
+template <typename Object, typename Balance>
+bool BST<Object, Balance>::retrieve(const Object& value) const {
+  return findNode(root, value) != nullptr;
+}
+
+// Bulk build from a range: one pass checks whether the input is already
+// ascending (counting distinct values); otherwise it is copied and sorted
+template <typename Object, typename Balance>
+template <typename Iterator>
+void BST<Object, Balance>::buildFrom(Iterator first, Iterator last) {
+  size_t distinct = 0;
+  bool ascending = true;
+  for (Iterator it = first, previous = first; it != last; previous = it, ++it) {
+    if (it == first || *previous < *it) {
+      ++distinct;
+    }
+    else if (*it < *previous) {
+      ascending = false;
+      break;
+    }
+  }
+
+  if (ascending) {
+    buildSorted(first, distinct);
+  }
+  else {
+    vector<Object> sorted(first, last);
+    sort(sorted.begin(), sorted.end());
+    sorted.erase(unique(sorted.begin(), sorted.end(),
+      [](const Object& a, const Object& b) { return !(a < b) && !(b < a); }), sorted.end());
+    buildSorted(sorted.begin(), sorted.size());
+  }
+}
+
+// Node i of the block holds the i-th smallest value. The root of the
+// values [low, high) is the middle one, so the two subtrees of every node
+// differ in size by at most one and the tree is perfectly balanced. The
+// links are made with an explicit stack of ranges, at most log2 n deep.
+template <typename Object, typename Balance>
+template <typename Iterator>
+void BST<Object, Balance>::buildSorted(Iterator first, size_t count) {
+  TreeNode* nodes = nullptr;
+  if (count > 0) {
+    nodes = static_cast<TreeNode*>(::operator new(count * sizeof(TreeNode)));
+    size_t constructed = 0;
+    try {
+      for (Iterator previous = first; constructed < count; previous = first, ++first) {
+        if (constructed > 0 && !(*previous < *first)) {
+          continue;   // Duplicate of the value before it
+        }
+        new (nodes + constructed) TreeNode(*first);
+        ++constructed;
+      }
+    }
+    catch (...) {
+      while (constructed > 0) {
+        nodes[--constructed].~TreeNode();
+      }
+      ::operator delete(nodes);
+      throw;
+    }
+  }
+
+  // Link each range's middle node to the middles of its two halves. A
+  // subtree of m nodes has floor(log2 m) + 1 levels.
+  struct Range {
+    size_t low;
+    size_t high;
+  };
+  Range pending[8 * sizeof(size_t) + 1];
+  int depth = 0;
+  if (count > 0) {
+    pending[depth++] = Range{ 0, count };
+  }
+  while (depth > 0) {
+    Range range = pending[--depth];
+    size_t mid = range.low + (range.high - range.low) / 2;
+    TreeNode* middle = &nodes[mid];
+    int levels = 0;
+    for (size_t size = range.high - range.low; size > 0; size >>= 1) {
+      ++levels;
+    }
+    Balance::setHeight(middle, levels);
+    if (range.low < mid) {
+      middle->left = &nodes[range.low + (mid - range.low) / 2];
+      pending[depth++] = Range{ range.low, mid };
+    }
+    if (mid + 1 < range.high) {
+      middle->right = &nodes[mid + 1 + (range.high - mid - 1) / 2];
+      pending[depth++] = Range{ mid + 1, range.high };
+    }
+  }
+
+  // Swap in the new tree only once it is complete
+  clear(root);
+  releaseBlock();
+  root = (count > 0) ? &nodes[count / 2] : nullptr;
+  if (count > 0) {
+    block = nodes;
+    blockEnd = nodes + count;
+  }
+}
+
+// Number of levels in the tree, counted one level at a time
+// (only balancing policies keep a height in their nodes)
+template <typename Object, typename Balance>
+int BST<Object, Balance>::height() const {
+  int levels = 0;
+  queue<Node<Object>*> level;
+  if (root != nullptr) {
+    level.push(root);
+  }
+  while (!level.empty()) {
+    ++levels;
+    for (size_t count = level.size(); count > 0; --count) {
+      Node<Object>* current = level.front();
+      level.pop();
+      if (current->left != nullptr) {
+        level.push(current->left);
+      }
+      if (current->right != nullptr) {
+        level.push(current->right);
+      }
+    }
+  }
+  return levels;
 }
 
 // Pre-order traversal: Root -> Left -> Right
 // Iterative implementation using stack
-template <typename Object>
-queue<Object> BST<Object>::pre_order_traversal(const Object& value) const {
+template <typename Object, typename Balance>
+queue<Object> BST<Object, Balance>::pre_order_traversal(const Object& value) const {
   queue<Object> result;
   Node<Object>* startNode = findNode(root, value);
 
@@ -134,8 +537,8 @@ queue<Object> BST<Object>::pre_order_traversal(const Object& value) const {
 // In-order traversal: Left -> Root -> Right  
 // Iterative implementation using stack
 // Produces sorted output for BST
-template <typename Object>
-queue<Object> BST<Object>::in_order_traversal(const Object& value) const {
+template <typename Object, typename Balance>
+queue<Object> BST<Object, Balance>::in_order_traversal(const Object& value) const {
   queue<Object> result;
   Node<Object>* startNode = findNode(root, value);
 
@@ -167,8 +570,8 @@ queue<Object> BST<Object>::in_order_traversal(const Object& value) const {
 
 // Post-order traversal: Left -> Right -> Root
 // Most complex iterative traversal using single stack
-template <typename Object>
-queue<Object> BST<Object>::post_order_traversal(const Object& value) const {
+template <typename Object, typename Balance>
+queue<Object> BST<Object, Balance>::post_order_traversal(const Object& value) const {
   queue<Object> result;
   Node<Object>* startNode = findNode(root, value);
 
@@ -204,4 +607,215 @@ queue<Object> BST<Object>::post_order_traversal(const Object& value) const {
   return result;
 }
 
+// Lazy pre-order traversal of the subtree rooted at value
+template <typename Object, typename Balance>
+TraversalRange<Object> BST<Object, Balance>::pre_order(const Object& value) const {
+  return TraversalRange<Object>(TreeIterator<Object>(findNode(root, value), PRE_ORDER));
+}
+
+// Lazy in-order traversal of the subtree rooted at value
+template <typename Object, typename Balance>
+TraversalRange<Object> BST<Object, Balance>::in_order(const Object& value) const {
+  return TraversalRange<Object>(TreeIterator<Object>(findNode(root, value), IN_ORDER));
+}
+
+// Lazy post-order traversal of the subtree rooted at value
+template <typename Object, typename Balance>
+TraversalRange<Object> BST<Object, Balance>::post_order(const Object& value) const {
+  return TraversalRange<Object>(TreeIterator<Object>(findNode(root, value), POST_ORDER));
+}
+
+// First value of the whole tree in ascending order
+template <typename Object, typename Balance>
+typename BST<Object, Balance>::const_iterator BST<Object, Balance>::begin() const {
+  return const_iterator(root, IN_ORDER);
+}
+
+// End of every traversal
+template <typename Object, typename Balance>
+typename BST<Object, Balance>::const_iterator BST<Object, Balance>::end() const {
+  return const_iterator();
+}
+
+// Callback pre-order traversal; stops when visit returns false
+template <typename Object, typename Balance>
+template <typename Visitor>
+bool BST<Object, Balance>::visitPreOrder(const Object& value, Visitor visit) const {
+  for (const Object& item : pre_order(value)) {
+    if (!visit(item)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Callback in-order traversal; stops when visit returns false
+template <typename Object, typename Balance>
+template <typename Visitor>
+bool BST<Object, Balance>::visitInOrder(const Object& value, Visitor visit) const {
+  for (const Object& item : in_order(value)) {
+    if (!visit(item)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Callback post-order traversal; stops when visit returns false
+template <typename Object, typename Balance>
+template <typename Visitor>
+bool BST<Object, Balance>::visitPostOrder(const Object& value, Visitor visit) const {
+  for (const Object& item : post_order(value)) {
+    if (!visit(item)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Read-only snapshot of the whole tree
+template <typename Object, typename Balance>
+FrozenBST<Object> BST<Object, Balance>::freeze() const {
+  return FrozenBST<Object>(begin(), end());
+}
+
+// Constructor: lays the ascending values out in Eytzinger order
+// Filling the implicit tree in in-order position order consumes the input
+// front to back, so one pass over it is enough.
+template <typename Object>
+template <typename Iterator>
+FrozenBST<Object>::FrozenBST(Iterator first, Iterator last)
+  : storage(nullptr), values(nullptr), count(static_cast<size_t>(std::distance(first, last))) {
+  storage = ::operator new((count + 1) * sizeof(Object) + CACHE_LINE);
+  uintptr_t address = reinterpret_cast<uintptr_t>(storage);
+  values = reinterpret_cast<Object*>((address + CACHE_LINE - 1) / CACHE_LINE * CACHE_LINE);
+
+  size_t constructed = 0;
+  try {
+    for (size_t k = firstIndex(); k != 0; k = nextIndex(k), ++first) {
+      new (values + k) Object(*first);
+      ++constructed;
+    }
+  }
+  catch (...) {
+    release(constructed);
+    throw;
+  }
+}
+
+// Move constructor: takes over the other snapshot's array
+template <typename Object>
+FrozenBST<Object>::FrozenBST(FrozenBST&& other)
+  : storage(other.storage), values(other.values), count(other.count) {
+  other.storage = nullptr;
+  other.values = nullptr;
+  other.count = 0;
+}
+
+// Move assignment: frees this snapshot and takes over the other's array
+template <typename Object>
+FrozenBST<Object>& FrozenBST<Object>::operator=(FrozenBST&& other) {
+  if (this != &other) {
+    release(count);
+    storage = other.storage;
+    values = other.values;
+    count = other.count;
+    other.storage = nullptr;
+    other.values = nullptr;
+    other.count = 0;
+  }
+  return *this;
+}
+
+// Destructor: destroys the values and frees the array
+template <typename Object>
+FrozenBST<Object>::~FrozenBST() {
+  release(count);
+}
+
+// Destroys values in in-order position order (the order they were built in)
+template <typename Object>
+void FrozenBST<Object>::release(size_t constructed) {
+  for (size_t k = firstIndex(); constructed > 0; k = nextIndex(k), --constructed) {
+    values[k].~Object();
+  }
+  ::operator delete(storage);
+  storage = nullptr;
+}
+
+// Leftmost node: keep taking the left child
+template <typename Object>
+size_t FrozenBST<Object>::firstIndex() const {
+  if (count == 0) {
+    return 0;
+  }
+  size_t k = 1;
+  while (2 * k <= count) {
+    k = 2 * k;
+  }
+  return k;
+}
+
+// In-order successor: the leftmost node of the right subtree, or else the
+// first ancestor reached from a left child
+template <typename Object>
+size_t FrozenBST<Object>::nextIndex(size_t k) const {
+  if (2 * k + 1 <= count) {
+    k = 2 * k + 1;
+    while (2 * k <= count) {
+      k = 2 * k;
+    }
+    return k;
+  }
+  return parentOfRightTurns(k);
+}
+
+// Drops the trailing 1 bits of k and one more bit: the ancestor reached by
+// climbing past the right turns and then one left turn
+template <typename Object>
+size_t FrozenBST<Object>::parentOfRightTurns(size_t k) {
+#if defined(__GNUC__)
+  return k >> (__builtin_ctzll(~static_cast<unsigned long long>(k)) + 1);
+#else
+  while (k & 1) {
+    k >>= 1;
+  }
+  return k >> 1;
+#endif
+}
+
+// Branchless descent: the comparison result is the next bit of the path.
+// After falling off the bottom, the answer is the last node where the path
+// turned left, so the trailing right turns and that left turn are stripped.
+template <typename Object>
+size_t FrozenBST<Object>::lowerBound(const Object& value) const {
+  size_t k = 1;
+  while (k <= count) {
+    // Integer address arithmetic: the hint may point past the array
+    BST_PREFETCH(reinterpret_cast<const void*>(
+      reinterpret_cast<uintptr_t>(values) + k * PREFETCH_STRIDE * sizeof(Object)));
+    k = 2 * k + (values[k] < value ? 1 : 0);
+  }
+  return parentOfRightTurns(k);
+}
+
+// Check if value exists: the lower bound must not be greater than it
+template <typename Object>
+bool FrozenBST<Object>::retrieve(const Object& value) const {
+  size_t k = lowerBound(value);
+  return k != 0 && !(value < values[k]);
+}
+
+// In-order scan from the lower bound of low until a value exceeds high
+template <typename Object>
+template <typename Visitor>
+bool FrozenBST<Object>::visitRange(const Object& low, const Object& high, Visitor visit) const {
+  for (size_t k = lowerBound(low); k != 0 && !(high < values[k]); k = nextIndex(k)) {
+    if (!visit(values[k])) {
+      return false;
+    }
+  }
+  return true;
+}
+
 #endif
\ No newline at end of file
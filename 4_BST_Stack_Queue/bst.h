@@ -1,9 +1,16 @@
 #ifndef BST_H
 #define BST_H
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <iostream>
+#include <iterator>
+#include <new>
 #include <stack>
 #include <queue>
+#include <vector>
 using namespace std;
 
 // Node structure for Binary Search Tree
@@ -18,18 +25,225 @@ struct Node {
   Node(const Object& value) : data(value), left(nullptr), right(nullptr) {}
 };
 
-// Binary Search Tree class template
-// Supports insertion, retrieval, and three types of tree traversals
+// Node of an AVL tree: a Node plus the height of its subtree
+template <typename Object>
+struct AvlNode : Node<Object> {
+  int height;            // Height of this subtree (leaf = 1)
+
+  AvlNode(const Object& value) : Node<Object>(value), height(1) {}
+};
+
+// Balancing policies
+// After an insert or remove, the tree calls Balance::rebalance on every node
+// on the path back up to the root, deepest first. rebalance may replace the
+// node (through the reference) by rotating its subtree. PATH_LENGTH bounds
+// the depth of that path; 0 means the policy never rebalances and no path
+// is recorded. The tree allocates its nodes as Balance::NodeType<Object>,
+// so a policy that keeps bookkeeping per node adds it there and plain trees
+// pay nothing for it; setHeight records the height of a node built by
+// buildFrom.
+
+// No balancing: the tree keeps the shape the insertions give it (the default)
+struct NoBalance {
+  static const int PATH_LENGTH = 0;
+
+  template <typename Object>
+  using NodeType = Node<Object>;
+
+  template <typename Object>
+  static void rebalance(Node<Object>*&) {}
+  template <typename Object>
+  static void setHeight(Node<Object>*, int) {}
+};
+
+// AVL balancing: the heights of every node's two subtrees differ by at most
+// one, so the tree height stays below 1.44 log2(n + 2)
+struct AvlBalance {
+  // Height bound for any tree that fits in a 64-bit address space
+  static const int PATH_LENGTH = 128;
+
+  template <typename Object>
+  using NodeType = AvlNode<Object>;
+
+  template <typename Object>
+  static void rebalance(Node<Object>*& node);
+  template <typename Object>
+  static void setHeight(Node<Object>* node, int height);
+
+private:
+  template <typename Object>
+  static int height(const Node<Object>* node);
+  template <typename Object>
+  static void update(Node<Object>* node);
+  template <typename Object>
+  static void rotateLeft(Node<Object>*& node);
+  template <typename Object>
+  static void rotateRight(Node<Object>*& node);
+};
+
+// Stack of node pointers for the lazy traversals
+// The first INLINE entries live inside the object, so walking a tree up to
+// INLINE levels deep (any AVL tree below 2^44 nodes) never allocates; deeper
+// entries spill into a vector.
+template <typename Object>
+class NodeStack {
+private:
+  static const size_t INLINE = 64;
+  const Node<Object>* fixed[INLINE];        // Entries 0 .. INLINE-1
+  vector<const Node<Object>*> overflow;     // Entries INLINE and up
+  size_t count;                             // Number of entries
+
+public:
+  NodeStack() : count(0) {}
+  NodeStack(const NodeStack& other);              // Copies only the entries in use
+  NodeStack& operator=(const NodeStack& other);
+
+  bool empty() const { return count == 0; }
+  void push(const Node<Object>* node);
+  const Node<Object>* top() const;
+  void pop();
+};
+
+// Order in which a traversal visits the nodes of a subtree
+enum TraversalOrder {
+  PRE_ORDER,    // Root->L->R
+  IN_ORDER,     // L->Root->R (ascending)
+  POST_ORDER    // L->R->Root
+};
+
+// Lazy forward iterator over a subtree in one of the three orders
+// Yields const references to the stored values: nothing is copied, and only
+// the nodes between the subtree root and the current one are kept on the
+// stack. A default-constructed iterator is the end of every traversal.
+// Modifying the tree invalidates its iterators.
+template <typename Object>
+class TreeIterator {
+private:
+  TraversalOrder order;
+  NodeStack<Object> stack;        // In/post-order: path to current; pre-order: pending right children
+  const Node<Object>* current;    // Node referred to; nullptr at the end
+
+  // Pushes the path from node down to the first node of its subtree in
+  // this order (leftmost for in-order, leftmost leaf for post-order)
+  void descend(const Node<Object>* node);
+
+public:
+  typedef forward_iterator_tag iterator_category;
+  typedef Object value_type;
+  typedef ptrdiff_t difference_type;
+  typedef const Object* pointer;
+  typedef const Object& reference;
+
+  TreeIterator() : order(IN_ORDER), current(nullptr) {}             // End iterator
+  TreeIterator(const Node<Object>* start, TraversalOrder walk);     // First node of start's subtree
+
+  const Object& operator*() const { return current->data; }
+  const Object* operator->() const { return &current->data; }
+  TreeIterator& operator++();
+  TreeIterator operator++(int);
+
+  bool operator==(const TreeIterator& other) const { return current == other.current; }
+  bool operator!=(const TreeIterator& other) const { return current != other.current; }
+};
+
+// A traversal as a range, for range-based for loops
+template <typename Object>
+class TraversalRange {
+private:
+  TreeIterator<Object> first;
+
+public:
+  explicit TraversalRange(const TreeIterator<Object>& start) : first(start) {}
+  TreeIterator<Object> begin() const { return first; }
+  TreeIterator<Object> end() const { return TreeIterator<Object>(); }
+};
+
+// Read-only snapshot of a BST in Eytzinger (breadth-first) order
+// values[1] is the root and the children of values[k] are values[2k] and
+// values[2k + 1], so a search walks down one array instead of chasing node
+// pointers, and the top levels share a few cache lines. The array starts on
+// a cache line boundary; each search step prefetches the line holding the
+// descendants several levels down, and picks the child with arithmetic
+// instead of a branch. Every search runs to the bottom level (about log2 n
+// steps). In-order scans step through the same implicit tree.
 template <typename Object>
+class FrozenBST {
+private:
+  static const size_t CACHE_LINE = 64;
+
+  // values[k * PREFETCH_STRIDE] starts the run of the node's descendants
+  // PREFETCH_STRIDE = 2^j levels down; it is chosen so that the run fills
+  // one cache line
+  static const size_t PREFETCH_STRIDE =
+    sizeof(Object) <= 4 ? 16 : sizeof(Object) <= 8 ? 8 : sizeof(Object) <= 16 ? 4 : 2;
+
+  void* storage;      // Raw allocation (values plus alignment slack)
+  Object* values;     // values[1 .. count]; values[0] is never constructed
+  size_t count;       // Number of values
+
+  FrozenBST(const FrozenBST&) = delete;
+  FrozenBST& operator=(const FrozenBST&) = delete;
+
+  // Index of the first node of the in-order sequence, and of the next one
+  // (0 after the last)
+  size_t firstIndex() const;
+  size_t nextIndex(size_t k) const;
+  static size_t parentOfRightTurns(size_t k);
+
+  // Index of the smallest value not less than value (0 if none)
+  size_t lowerBound(const Object& value) const;
+
+  // Destroys the first 'constructed' values in in-order position and frees
+  // the storage
+  void release(size_t constructed);
+
+public:
+  // Builds the snapshot from values in ascending order without duplicates
+  // (e.g. a BST's begin() and end())
+  template <typename Iterator>
+  FrozenBST(Iterator first, Iterator last);
+
+  FrozenBST(FrozenBST&& other);
+  FrozenBST& operator=(FrozenBST&& other);
+  ~FrozenBST();
+
+  size_t size() const { return count; }
+
+  // Check if value exists
+  bool retrieve(const Object& value) const;
+
+  // Calls visit(const Object&) for every value in [low, high] in ascending
+  // order; visit returns false to stop early. Returns false if stopped.
+  template <typename Visitor>
+  bool visitRange(const Object& low, const Object& high, Visitor visit) const;
+};
+
+// Binary Search Tree class template
+// Supports insertion, removal, retrieval, and three types of tree traversals.
+// The Balance policy (NoBalance or AvlBalance) decides whether the tree
+// rebalances itself after insertions and removals.
+template <typename Object, typename Balance = NoBalance>
 class BST {
 private:
+  // Type the nodes are allocated as (Node<Object> plus the policy's fields)
+  typedef typename Balance::template NodeType<Object> TreeNode;
+
   Node<Object>* root;    // Root pointer of the BST
+  TreeNode* block;       // Node array allocated by buildFrom (nullptr if none)
+  TreeNode* blockEnd;    // One past the last node of the array
 
-  // Private recursive helper methods
-  void insert(Node<Object>*& node, const Object& value);
-  bool retrieve(Node<Object>* node, const Object& value) const;
+  // Private iterative helper methods (no recursion, so a degenerate tree
+  // cannot overflow the call stack)
+  void rebalancePath(Node<Object>** path[], int length);
   Node<Object>* findNode(Node<Object>* node, const Object& value) const;
   void clear(Node<Object>* node);
+  void destroyNode(Node<Object>* node);
+  void releaseBlock();
+
+  // Builds a balanced tree from 'count' distinct ascending values
+  // (duplicates in the input are skipped) in one block of nodes
+  template <typename Iterator>
+  void buildSorted(Iterator first, size_t count);
 
 public:
   BST();      // Constructor
@@ -37,12 +251,48 @@ public:
 
   // Public interface methods
   void insert(const Object& value);           // Insert value into BST
+  bool remove(const Object& value);           // Remove value; false if not found
   bool retrieve(const Object& value) const;   // Check if value exists
+  int height() const;                         // Number of levels (0 if empty)
+
+  // Replaces the contents with the values of a range (forward iterators),
+  // ignoring duplicates. Ascending input is detected and built directly in
+  // O(n); other input is sorted first. The result is perfectly balanced
+  // (valid for every Balance policy), and its nodes share one allocation.
+  template <typename Iterator>
+  void buildFrom(Iterator first, Iterator last);
+  template <typename Range>
+  void buildFrom(const Range& values) { buildFrom(std::begin(values), std::end(values)); }
 
   // Traversal methods that return queues of values
   queue<Object> pre_order_traversal(const Object& value) const; // Root->L->R
   queue<Object> in_order_traversal(const Object& value) const;  // L->Root->R 
   queue<Object> post_order_traversal(const Object& value) const;// L->R->Root
+
+  // Lazy traversals of the subtree rooted at value (empty if not found)
+  typedef TreeIterator<Object> const_iterator;
+  TraversalRange<Object> pre_order(const Object& value) const;
+  TraversalRange<Object> in_order(const Object& value) const;
+  TraversalRange<Object> post_order(const Object& value) const;
+
+  // In-order iteration over the whole tree (ascending values)
+  const_iterator begin() const;
+  const_iterator end() const;
+
+  // Callback traversals of the subtree rooted at value: visit(const Object&)
+  // is called for each value and returns false to stop the walk early.
+  // Return false if the walk was stopped, true otherwise (also when value
+  // is not found).
+  template <typename Visitor>
+  bool visitPreOrder(const Object& value, Visitor visit) const;
+  template <typename Visitor>
+  bool visitInOrder(const Object& value, Visitor visit) const;
+  template <typename Visitor>
+  bool visitPostOrder(const Object& value, Visitor visit) const;
+
+  // Read-only snapshot of the current values for fast lookups and range
+  // scans (see FrozenBST). Later changes to the tree do not affect it.
+  FrozenBST<Object> freeze() const;
 };
 
 // Include the implementation for template class
@@ -4,9 +4,11 @@
 // Memory Check: valgrind --leak-check=full ./bst_driver
 
 #include "bst.h"
+#include "arena_bst.h"
 #include <iostream>
 #include <string>
 #include <cassert>
+#include <vector>
 
 using namespace std;
 
@@ -176,6 +178,388 @@ void testEdgeCases() {
   cout << "\n  Expected: 1 2 3 4 5" << endl;
 }
 
+// Test removal on the unbalanced tree: leaf, one child, two children, root
+void testRemove() {
+  cout << "\n=== Testing Removal ===" << endl;
+  BST<int> tree;
+  cout << "Inserting values: 4, 2, 1, 3, 6, 5, 7, 8" << endl;
+  int values[] = { 4, 2, 1, 3, 6, 5, 7, 8 };
+  for (int v : values) {
+    tree.insert(v);
+  }
+
+  cout << "  remove(9) (not present): " << (!tree.remove(9) ? "PASS" : "FAIL")
+    << " (expected: false)" << endl;
+  cout << "  remove(1) (leaf): " << (tree.remove(1) && !tree.retrieve(1) ? "PASS" : "FAIL") << endl;
+  cout << "  remove(7) (one child): " << (tree.remove(7) && !tree.retrieve(7) ? "PASS" : "FAIL") << endl;
+  cout << "  remove(4) (root, two children): " << (tree.remove(4) && !tree.retrieve(4) ? "PASS" : "FAIL") << endl;
+
+  cout << "\nPre-order traversal from new root (5):" << endl;
+  queue<int> result = tree.pre_order_traversal(5);
+  cout << "  Result: ";
+  while (!result.empty()) {
+    cout << result.front() << " ";
+    result.pop();
+  }
+  cout << "\n  Expected: 5 2 3 6 8" << endl;
+
+  cout << "  remove all: ";
+  bool allRemoved = tree.remove(2) && tree.remove(3) && tree.remove(5) && tree.remove(6) && tree.remove(8);
+  cout << (allRemoved && tree.height() == 0 ? "PASS" : "FAIL") << " (expected: empty tree)" << endl;
+}
+
+// Test the AVL balancing policy against the degenerate ascending input
+void testBalancedBST() {
+  cout << "\n=== Testing Balanced BST (AvlBalance) ===" << endl;
+  BST<int> plain;
+  BST<int, AvlBalance> avl;
+  for (int i = 1; i <= 5; ++i) {
+    plain.insert(i);
+    avl.insert(i);
+  }
+  cout << "Inserting 1..5 in ascending order:" << endl;
+  cout << "  Unbalanced height: " << plain.height() << " (expected: 5)" << endl;
+  cout << "  AVL height: " << avl.height() << " (expected: 3)" << endl;
+  cout << "  Test: " << (avl.height() == 3 ? "PASS" : "FAIL") << endl;
+
+  cout << "\nPre-order traversal of AVL tree from root (2):" << endl;
+  queue<int> result = avl.pre_order_traversal(2);
+  cout << "  Result: ";
+  while (!result.empty()) {
+    cout << result.front() << " ";
+    result.pop();
+  }
+  cout << "\n  Expected: 2 1 4 3 5" << endl;
+
+  // 2^16 - 1 ascending keys give a perfect tree of 16 levels
+  BST<int, AvlBalance> large;
+  const int count = 65535;
+  for (int i = 1; i <= count; ++i) {
+    large.insert(i);
+  }
+  cout << "\nInserting 1.." << count << " in ascending order:" << endl;
+  cout << "  AVL height: " << large.height() << " (expected: 16)" << endl;
+  cout << "  Test: " << (large.height() == 16 ? "PASS" : "FAIL") << endl;
+
+  bool found = true;
+  for (int i = 1; i <= count; i += 97) {
+    found = found && large.retrieve(i);
+  }
+  cout << "  retrieve sample: " << (found && !large.retrieve(count + 1) ? "PASS" : "FAIL") << endl;
+
+  // Remove every even key; the tree must stay balanced and sorted
+  bool removed = true;
+  for (int i = 2; i <= count; i += 2) {
+    removed = removed && large.remove(i);
+  }
+  cout << "\nRemoving every even key:" << endl;
+  cout << "  remove: " << (removed && !large.retrieve(2) && large.retrieve(3) ? "PASS" : "FAIL") << endl;
+  cout << "  AVL height: " << large.height() << " (expected: at most 16)" << endl;
+  cout << "  Test: " << (large.height() <= 16 ? "PASS" : "FAIL") << endl;
+
+  // In-order from the root covers every remaining key in ascending order
+  BST<int, AvlBalance> small;
+  for (int i = 10; i >= 1; --i) {
+    small.insert(i);
+  }
+  small.remove(7);
+  small.remove(4);
+  small.remove(10);
+  cout << "\nIn-order traversal of AVL tree (10..1 inserted, 7, 4, 10 removed):" << endl;
+  bool sorted = true;
+  int previous = 0;
+  int seen = 0;
+  for (int i = 1; i <= 10; ++i) {
+    queue<int> subtree = small.in_order_traversal(i);
+    if ((int)subtree.size() > seen) {
+      seen = (int)subtree.size();
+      result = subtree;
+    }
+  }
+  cout << "  Result: ";
+  while (!result.empty()) {
+    sorted = sorted && result.front() > previous;
+    previous = result.front();
+    cout << result.front() << " ";
+    result.pop();
+  }
+  cout << "\n  Expected: 1 2 3 5 6 8 9" << endl;
+  cout << "  Test: " << (sorted && seen == 7 ? "PASS" : "FAIL") << endl;
+}
+
+// Test a degenerate tree far deeper than a recursive walk could handle:
+// insert, retrieve, remove and the destructor all work without recursion
+void testDeepSkewedTree() {
+  cout << "\n=== Testing Deep Skewed Tree ===" << endl;
+  const int count = 20000;
+  bool ok = true;
+  {
+    BST<int> deep;
+    for (int i = 0; i < count; ++i) {
+      deep.insert(i);
+    }
+    cout << "Inserted 0.." << count - 1 << " in ascending order" << endl;
+    cout << "  height: " << deep.height() << " (expected: " << count << ")" << endl;
+    ok = ok && deep.height() == count;
+    ok = ok && deep.retrieve(count - 1) && !deep.retrieve(count);
+    ok = ok && deep.remove(count - 1) && deep.remove(0) && !deep.retrieve(count - 1);
+    cout << "  retrieve/remove at the bottom: " << (ok ? "PASS" : "FAIL") << endl;
+
+    // Every traversal's stack grows to the full depth here
+    int visited = 0;
+    for (BST<int>::const_iterator it = deep.begin(); it != deep.end(); ++it) {
+      ++visited;
+    }
+    int postVisited = 0;
+    deep.visitPostOrder(1, [&](const int&) { ++postVisited; return true; });
+    cout << "  iterate all levels: " << (visited == count - 2 && postVisited == count - 2 ? "PASS" : "FAIL") << endl;
+  } // Destructor tears down the 19998-level chain here
+  cout << "  destructor: PASS" << endl;
+}
+
+// Copies a traversal queue into a vector for comparisons
+template <typename Object>
+vector<Object> drain(queue<Object> values) {
+  vector<Object> result;
+  while (!values.empty()) {
+    result.push_back(values.front());
+    values.pop();
+  }
+  return result;
+}
+
+// Test the lazy iterators and visitor callbacks against the queue traversals
+void testLazyTraversals() {
+  cout << "\n=== Testing Lazy Iterators and Visitors ===" << endl;
+  BST<int> tree;
+  int values[] = { 8, 4, 12, 2, 6, 10, 14, 1, 3, 5, 7, 9, 11, 13, 15, 16 };
+  for (int v : values) {
+    tree.insert(v);
+  }
+
+  // Every order, from the root and from inner and leaf nodes
+  bool same = true;
+  int starts[] = { 8, 4, 12, 14, 1, 99 };
+  for (int start : starts) {
+    vector<int> pre, in, post;
+    for (const int& v : tree.pre_order(start)) pre.push_back(v);
+    for (const int& v : tree.in_order(start)) in.push_back(v);
+    for (const int& v : tree.post_order(start)) post.push_back(v);
+    same = same && pre == drain(tree.pre_order_traversal(start));
+    same = same && in == drain(tree.in_order_traversal(start));
+    same = same && post == drain(tree.post_order_traversal(start));
+  }
+  cout << "  Iterators match queue traversals: " << (same ? "PASS" : "FAIL") << endl;
+
+  cout << "\nWhole tree with begin()/end():" << endl;
+  cout << "  Result: ";
+  const BST<int>& const_tree = tree;
+  int expected = 1;
+  bool ascending = true;
+  for (BST<int>::const_iterator it = const_tree.begin(); it != const_tree.end(); ++it) {
+    cout << *it << " ";
+    ascending = ascending && *it == expected++;
+  }
+  cout << "\n  Expected: 1 2 ... 16" << endl;
+  cout << "  Test: " << (ascending && expected == 17 ? "PASS" : "FAIL") << endl;
+
+  // Early termination: stop after the first three values
+  vector<int> firstThree;
+  bool finished = tree.visitInOrder(8, [&](const int& v) {
+    firstThree.push_back(v);
+    return firstThree.size() < 3;
+  });
+  cout << "\nvisitInOrder stopping after 3 values:" << endl;
+  cout << "  Result: ";
+  for (int v : firstThree) cout << v << " ";
+  cout << "\n  Expected: 1 2 3" << endl;
+  cout << "  Test: " << (!finished && firstThree.size() == 3 && firstThree[2] == 3 ? "PASS" : "FAIL") << endl;
+
+  vector<int> pre, post;
+  bool complete = tree.visitPreOrder(4, [&](const int& v) { pre.push_back(v); return true; }) &&
+    tree.visitPostOrder(4, [&](const int& v) { post.push_back(v); return true; });
+  cout << "  visitPreOrder/visitPostOrder from (4): "
+    << (complete && pre == drain(tree.pre_order_traversal(4)) && post == drain(tree.post_order_traversal(4)) ? "PASS" : "FAIL")
+    << endl;
+  cout << "  visitInOrder from missing node (99): "
+    << (tree.visitInOrder(99, [](const int&) { return false; }) ? "PASS" : "FAIL")
+    << " (expected: no calls)" << endl;
+
+  // Values are handed out by reference, not copied
+  BST<string> names;
+  names.insert("M");
+  names.insert("C");
+  names.insert("X");
+  const string* first = &*names.begin();
+  cout << "  References stay valid across iteration: "
+    << (*first == "C" && &*names.in_order("C").begin() == first ? "PASS" : "FAIL") << endl;
+}
+
+// Test the frozen Eytzinger snapshot: lookups, range scans, independence
+void testFrozenBST() {
+  cout << "\n=== Testing Frozen Snapshot (FrozenBST) ===" << endl;
+  BST<int, AvlBalance> tree;
+  for (int i = 1; i <= 1000; ++i) {
+    tree.insert(3 * i);
+  }
+  FrozenBST<int> frozen = tree.freeze();
+  cout << "  size: " << frozen.size() << " (expected: 1000)" << endl;
+
+  bool lookups = true;
+  for (int i = 0; i <= 3002; ++i) {
+    lookups = lookups && frozen.retrieve(i) == tree.retrieve(i);
+  }
+  cout << "  retrieve matches the tree for 0..3002: " << (lookups ? "PASS" : "FAIL") << endl;
+
+  cout << "\nRange scan [10, 30]:" << endl;
+  cout << "  Result: ";
+  vector<int> range;
+  frozen.visitRange(10, 30, [&](const int& v) { range.push_back(v); return true; });
+  for (int v : range) cout << v << " ";
+  cout << "\n  Expected: 12 15 18 21 24 27 30" << endl;
+  cout << "  Test: " << (range.size() == 7 && range.front() == 12 && range.back() == 30 ? "PASS" : "FAIL") << endl;
+
+  vector<int> all;
+  frozen.visitRange(0, 5000, [&](const int& v) { all.push_back(v); return true; });
+  bool sorted = all.size() == 1000;
+  for (size_t i = 0; sorted && i < all.size(); ++i) {
+    sorted = all[i] == 3 * (int)(i + 1);
+  }
+  cout << "  Full scan in ascending order: " << (sorted ? "PASS" : "FAIL") << endl;
+
+  int seen = 0;
+  bool finished = frozen.visitRange(0, 5000, [&](const int&) { return ++seen < 5; });
+  cout << "  Early termination after 5: " << (!finished && seen == 5 ? "PASS" : "FAIL") << endl;
+  cout << "  Empty range (1, 2): "
+    << (frozen.visitRange(1, 2, [](const int&) { return false; }) ? "PASS" : "FAIL") << endl;
+
+  // The snapshot does not follow later changes to the tree
+  tree.remove(3);
+  tree.insert(4);
+  cout << "  Snapshot unchanged after tree edits: "
+    << (frozen.retrieve(3) && !frozen.retrieve(4) ? "PASS" : "FAIL") << endl;
+
+  BST<string> empty;
+  FrozenBST<string> none = empty.freeze();
+  cout << "  Empty snapshot: " << (none.size() == 0 && !none.retrieve("A") ? "PASS" : "FAIL") << endl;
+}
+
+// Test bulk building from sorted, unsorted and duplicate input
+void testBuildFrom() {
+  cout << "\n=== Testing Bulk Build (buildFrom) ===" << endl;
+  const int count = 100000;
+  vector<int> ascending;
+  for (int i = 1; i <= count; ++i) {
+    ascending.push_back(i);
+  }
+
+  BST<int> tree;
+  tree.buildFrom(ascending);
+  cout << "Building from 1.." << count << " (sorted):" << endl;
+  cout << "  height: " << tree.height() << " (expected: 17)" << endl;
+  int expected = 1;
+  bool ordered = true;
+  for (const int& v : tree) {
+    ordered = ordered && v == expected++;
+  }
+  cout << "  Test: " << (tree.height() == 17 && ordered && expected == count + 1 ? "PASS" : "FAIL") << endl;
+
+  cout << "\nRebuilding from 5, 3, 9, 3, 1, 7, 5 (unsorted, duplicates):" << endl;
+  int mixed[] = { 5, 3, 9, 3, 1, 7, 5 };
+  tree.buildFrom(mixed);
+  queue<int> result = tree.pre_order_traversal(5);
+  cout << "  Pre-order: ";
+  while (!result.empty()) {
+    cout << result.front() << " ";
+    result.pop();
+  }
+  cout << "\n  Expected: 5 3 1 9 7" << endl;
+  cout << "  Old values gone: " << (!tree.retrieve(count) && tree.height() == 3 ? "PASS" : "FAIL") << endl;
+
+  // Built nodes and inserted nodes can be mixed and removed in any order
+  tree.insert(4);
+  tree.insert(10);
+  bool removed = tree.remove(5) && tree.remove(4) && tree.remove(1) && tree.remove(10);
+  cout << "  Insert/remove after build: " << (removed && tree.retrieve(3) && tree.retrieve(9) && !tree.retrieve(5) ? "PASS" : "FAIL") << endl;
+
+  BST<int, AvlBalance> avl;
+  avl.buildFrom(ascending.begin(), ascending.end());
+  for (int i = 1; i <= count; i += 2) {
+    avl.remove(i);
+  }
+  cout << "  AVL build then remove half: height " << avl.height() << " (expected: at most 17) "
+    << (avl.height() <= 17 && avl.retrieve(2) && !avl.retrieve(1) ? "PASS" : "FAIL") << endl;
+
+  vector<string> none;
+  BST<string> empty;
+  empty.insert("A");
+  empty.buildFrom(none);
+  cout << "  Build from empty range: " << (empty.height() == 0 && !empty.retrieve("A") ? "PASS" : "FAIL") << endl;
+}
+
+// Test the arena-backed tree: removal, slot reuse, deep trees, strings, clear
+void testArenaBST() {
+  cout << "\n=== Testing Arena-Backed BST ===" << endl;
+  ArenaBST<int> tree;
+  int values[] = { 4, 2, 1, 3, 6, 5, 7, 4 };
+  for (int v : values) {
+    tree.insert(v);
+  }
+  vector<int> visited;
+  tree.visitInOrder([&](const int& v) { visited.push_back(v); return true; });
+  cout << "Inserting 4, 2, 1, 3, 6, 5, 7, 4:" << endl;
+  cout << "  In-order: ";
+  for (int v : visited) {
+    cout << v << " ";
+  }
+  cout << "\n  Expected: 1 2 3 4 5 6 7" << endl;
+  cout << "  Test: " << (tree.size() == 7 && tree.height() == 3 && visited.size() == 7 ? "PASS" : "FAIL") << endl;
+
+  bool removed = tree.remove(4) && tree.remove(1) && !tree.remove(8);
+  cout << "  Remove root and leaf: " << (removed && !tree.retrieve(4) && tree.retrieve(5) && tree.size() == 5 ? "PASS" : "FAIL") << endl;
+
+  // A skewed tree is walked without recursion
+  const int count = 20000;
+  tree.clear();
+  for (int i = 1; i <= count; ++i) {
+    tree.insert(i);
+  }
+  cout << "  Skewed " << count << " nodes: "
+    << (tree.height() == count && tree.retrieve(count) && !tree.retrieve(count + 1) ? "PASS" : "FAIL") << endl;
+
+  // Slots freed by remove are reused before the arena grows
+  ArenaBST<int> scattered;
+  const int keys = 1 << 16;
+  for (int i = 0; i < keys; ++i) {
+    scattered.insert((i * 7919) % keys);
+  }
+  size_t bytes = scattered.memoryUsage();
+  for (int i = 0; i < keys; i += 2) {
+    scattered.remove(i);
+  }
+  for (int i = 0; i < keys; i += 2) {
+    scattered.insert(i + keys);
+  }
+  cout << "  Remove half, insert as many: "
+    << (scattered.size() == size_t(keys) && scattered.memoryUsage() == bytes && scattered.retrieve(keys) && !scattered.retrieve(0) ? "PASS" : "FAIL") << endl;
+  cout << "  Node size: " << sizeof(ArenaNode<int>) << " bytes (Node<int>: " << sizeof(Node<int>) << ")" << endl;
+
+  int seen = 0;
+  bool finished = tree.visitInOrder([&](const int& v) { seen = v; return v < 10; });
+  cout << "  Visitor stops early: " << (!finished && seen == 10 ? "PASS" : "FAIL") << endl;
+
+  ArenaBST<string> names;
+  names.insert("Mary");
+  names.insert("Bob");
+  names.insert("Zoe");
+  names.remove("Mary");
+  names.insert("Alice");
+  cout << "  Strings: " << (names.retrieve("Alice") && names.retrieve("Zoe") && !names.retrieve("Mary") ? "PASS" : "FAIL") << endl;
+  names.clear();
+  scattered.clear();
+  cout << "  Clear: " << (names.size() == 0 && !names.retrieve("Bob") && scattered.height() == 0 && scattered.memoryUsage() < bytes ? "PASS" : "FAIL") << endl;
+}
+
 void testConstCorrectness() {
   cout << "\n=== Testing Const Correctness ===" << endl;
   BST<int> tree;
@@ -205,6 +589,13 @@ int main() {
   testIntegerBST();
   testStringBST();
   testEdgeCases();
+  testRemove();
+  testBalancedBST();
+  testDeepSkewedTree();
+  testLazyTraversals();
+  testFrozenBST();
+  testBuildFrom();
+  testArenaBST();
   testConstCorrectness();
 
   cout << "\n========================================" << endl;